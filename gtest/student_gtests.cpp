@@ -3,8 +3,17 @@
 #include <string>
 #include <vector>
 #include <sstream>
-#include "/home/zhouhent/ICS46/HW9/src/dijkstras.h"
-#include "/home/zhouhent/ICS46/HW9/src/ladder.h"
+#include <filesystem>
+#include <random>
+#include "dijkstras.h"
+#include "priority_queues.h"
+#include "ladder.h"
+#include "ladder_cache.h"
+#include "contraction_hierarchy.h"
+#include "landmarks.h"
+#include "delta_stepping.h"
+#include "dynamic_sssp.h"
+#include "generators.h"
 
 // Explicitly declare the ladder functions we're testing
 extern bool edit_distance_within(const std::string& str1, const std::string& str2, int d);
@@ -45,6 +54,30 @@ TEST(Ladder, Edit_Distance_Within) {
     EXPECT_FALSE(edit_distance_within("computer", "commuter", 1));
 }
 
+TEST(Ladder, Edit_Distance_Within_Long) {
+    // Patterns past 64 characters take the multi-word bit-parallel path
+    std::string base;
+    for (int i = 0; i < 150; i++) base += "abcdefghij"[(i * 7) % 10];
+
+    std::string edited = base;
+    edited[10] = 'Z';             // Substitution
+    edited.erase(80, 1);          // Deletion in the second 64-bit block
+    edited.insert(140, "q");      // Insertion near the end
+    EXPECT_TRUE(edit_distance_within(base, edited, 3));
+    EXPECT_FALSE(edit_distance_within(base, edited, 2));
+
+    // Case insensitivity holds across block boundaries
+    std::string upper = base;
+    for (char& c : upper) c = toupper(c);
+    EXPECT_TRUE(edit_distance_within(base, upper, 0));
+
+    // Within a single word, around the 64-character boundary
+    EXPECT_TRUE(edit_distance_within(base.substr(0, 64), base.substr(0, 66), 2));
+    EXPECT_FALSE(edit_distance_within(base.substr(0, 64), base.substr(0, 66), 1));
+    EXPECT_TRUE(edit_distance_within("kitten", "sitting", 3));
+    EXPECT_FALSE(edit_distance_within("kitten", "sitting", 2));
+}
+
 TEST(Ladder, Is_Adjacent) {
     // Test exact same words (not adjacent)
     EXPECT_FALSE(is_adjacent("world", "world"));
@@ -96,6 +129,106 @@ TEST(Ladder, Generate_Word_Ladder) {
     EXPECT_EQ(result.size(), 4);
 }
 
+TEST(Ladder, Bidirectional_Word_Ladder) {
+    std::set<std::string> word_list = {"cold", "gold", "golf", "wolf", "word", "wood", "wool", "world", "worlds"};
+    LadderIndex index(word_list);
+
+    std::vector<std::string> expected = {"cold", "gold", "golf", "wolf"};
+    EXPECT_EQ(generate_word_ladder("cold", "wolf", index, LadderSearch::Bidirectional), expected);
+
+    // Begin word outside the dictionary
+    expected = {"wore", "word", "world", "worlds"};
+    EXPECT_EQ(generate_word_ladder("wore", "worlds", index, LadderSearch::Bidirectional), expected);
+
+    EXPECT_TRUE(generate_word_ladder("cold", "cold", index, LadderSearch::Bidirectional).empty());
+    EXPECT_TRUE(generate_word_ladder("cold", "bold", index, LadderSearch::Bidirectional).empty());
+
+    // Same ladder lengths as the one-sided search on the full dictionary
+    std::set<std::string> dictionary;
+    load_words(dictionary, "words.txt");
+    LadderIndex full(dictionary);
+    for (auto [begin, end] : {std::pair{"cat", "dog"}, {"marty", "curls"}, {"code", "data"},
+                              {"work", "play"}, {"sleep", "awake"}, {"car", "cheat"}}) {
+        EXPECT_EQ(generate_word_ladder(begin, end, full, LadderSearch::Bidirectional).size(),
+                  generate_word_ladder(begin, end, full).size()) << begin << " -> " << end;
+    }
+}
+
+TEST(Ladder, Parallel_Word_Ladder) {
+    std::set<std::string> word_list = {"cold", "gold", "golf", "wolf", "word", "wood", "wool", "world", "worlds"};
+    LadderIndex index(word_list);
+
+    // A threshold of 1 forces every level through the thread pool
+    ParallelLadderOptions options;
+    options.threads = 4;
+    options.min_parallel_frontier = 1;
+    std::vector<std::string> expected = {"cold", "gold", "golf", "wolf"};
+    EXPECT_EQ(find_word_ladder("cold", "wolf", index, LadderSearch::Parallel, options).ladder, expected);
+    EXPECT_EQ(find_word_ladder("wore", "worlds", index, LadderSearch::Parallel, options).ladder.size(), 4);
+    EXPECT_EQ(find_word_ladder("gold", "word", index, LadderSearch::Parallel, options).error, "No word ladder exists");
+
+    std::set<std::string> dictionary;
+    load_words(dictionary, "words.txt");
+    LadderIndex full(dictionary);
+    for (auto [begin, end] : {std::pair{"cat", "dog"}, {"marty", "curls"}, {"code", "data"},
+                              {"work", "play"}, {"sleep", "awake"}, {"car", "cheat"}}) {
+        std::vector<std::string> ladder = find_word_ladder(begin, end, full, LadderSearch::Parallel, options).ladder;
+        EXPECT_EQ(ladder.size(), generate_word_ladder(begin, end, full).size()) << begin << " -> " << end;
+        for (size_t i = 1; i < ladder.size(); i++) {
+            EXPECT_TRUE(is_adjacent(ladder[i - 1], ladder[i])) << ladder[i - 1] << " " << ladder[i];
+        }
+    }
+}
+
+TEST(Ladder, AStar_Word_Ladder) {
+    std::set<std::string> word_list = {"cold", "gold", "golf", "wolf", "word", "wood", "wool", "world", "worlds"};
+    LadderIndex index(word_list);
+
+    std::vector<std::string> expected = {"cold", "gold", "golf", "wolf"};
+    EXPECT_EQ(find_word_ladder("cold", "wolf", index, LadderSearch::AStar).ladder, expected);
+    EXPECT_EQ(find_word_ladder("wore", "worlds", index, LadderSearch::AStar).ladder.size(), 4);
+    EXPECT_EQ(find_word_ladder("gold", "word", index, LadderSearch::AStar).error, "No word ladder exists");
+
+    // Same ladder lengths as BFS on the full dictionary, without expanding more words
+    Dictionary dictionary;
+    load_words(dictionary, "words.txt");
+    LadderIndex full(std::move(dictionary));
+    for (auto [begin, end] : {std::pair{"cat", "dog"}, {"marty", "curls"}, {"code", "data"},
+                              {"work", "play"}, {"sleep", "awake"}, {"car", "cheat"}}) {
+        LadderResult astar = find_word_ladder(begin, end, full, LadderSearch::AStar);
+        LadderResult bfs = find_word_ladder(begin, end, full, LadderSearch::BFS);
+        EXPECT_EQ(astar.ladder.size(), bfs.ladder.size()) << begin << " -> " << end;
+        EXPECT_LE(astar.stats.nodes_expanded, bfs.stats.nodes_expanded) << begin << " -> " << end;
+    }
+}
+
+TEST(Ladder, Ladder_Stats) {
+    if (!STATS_ENABLED) GTEST_SKIP() << "Built with HW9_STATS=0";
+    LadderIndex index(std::set<std::string>{"cat", "cot", "cog", "dog"});
+
+    LadderResult result = find_word_ladder("cat", "dog", index);
+    EXPECT_EQ(result.stats.nodes_expanded, 3);   // cat, cot, cog
+    EXPECT_EQ(result.stats.candidates, 5);       // cot; cat, cog; cot, dog
+    EXPECT_EQ(result.stats.is_adjacent_calls, 0);
+    EXPECT_GE(result.stats.peak_queue_bytes, sizeof(int));
+
+    // With a cache, a begin word outside the dictionary is checked against every word
+    // of length 2..4
+    write_ladder_cache(index, "test_stats.ladder");
+    LadderIndex cached(index.dictionary(), LadderCache::open("test_stats.ladder", index.dictionary()));
+    remove("test_stats.ladder");
+    for (LadderSearch search : {LadderSearch::BFS, LadderSearch::Bidirectional, LadderSearch::Parallel,
+                                LadderSearch::AStar}) {
+        result = find_word_ladder("bat", "dog", cached, search);
+        EXPECT_EQ(result.ladder.size(), 5);
+        EXPECT_EQ(result.stats.is_adjacent_calls, 4);
+        EXPECT_GE(result.stats.candidates, result.stats.nodes_expanded);
+        EXPECT_GT(result.stats.peak_queue_bytes, 0);
+    }
+    EXPECT_EQ(to_json(LadderStats{1, 2, 3, 4}),
+              "{\"nodes_expanded\": 1, \"candidates\": 2, \"is_adjacent_calls\": 3, \"peak_queue_bytes\": 4}");
+}
+
 TEST(Ladder, Load_Words) {
     // Create a temporary test file
     std::ofstream testFile("test_words.txt");
@@ -121,6 +254,111 @@ TEST(Ladder, Load_Words) {
     remove("test_words.txt");
 }
 
+TEST(Ladder, Dictionary) {
+    std::set<std::string> word_list = {"Cat", "cat", "dog", "at", "bird", "cot"};
+    Dictionary dictionary(word_list);
+
+    // Lowercased, deduplicated, ids in sorted order
+    ASSERT_EQ(dictionary.size(), 5);
+    EXPECT_EQ(dictionary.word(0), "at");
+    EXPECT_EQ(dictionary.word(4), "dog");
+    EXPECT_EQ(dictionary.find("cot"), 3);
+    EXPECT_EQ(dictionary.find("Cat"), -1);
+    EXPECT_EQ(dictionary.find("cow"), -1);
+    EXPECT_EQ(dictionary.max_length(), 4);
+
+    std::vector<int> three(dictionary.words_of_length(3).begin(), dictionary.words_of_length(3).end());
+    EXPECT_EQ(three, (std::vector<int>{2, 3, 4}));
+    EXPECT_TRUE(dictionary.words_of_length(7).empty());
+
+    // Ladders straight from a Dictionary match the set<string> adapter
+    EXPECT_EQ(generate_word_ladder("cat", "dog", dictionary), generate_word_ladder("cat", "dog", word_list));
+
+    std::ofstream testFile("test_dictionary.txt");
+    testFile << "Blue\nred  green\n\nred\n";
+    testFile.close();
+    Dictionary loaded;
+    load_words(loaded, "test_dictionary.txt");
+    EXPECT_EQ(loaded.size(), 3);
+    EXPECT_TRUE(loaded.contains("blue"));
+    remove("test_dictionary.txt");
+}
+
+TEST(Ladder, Load_Words_Mapped) {
+    std::ofstream testFile("test_mapped.txt");
+    testFile << "Blue\r\nRED\tgreen\n\n  red";
+    testFile.close();
+
+    Dictionary mapped, streamed;
+    load_words_mapped(mapped, "test_mapped.txt");
+    load_words(streamed, "test_mapped.txt");
+    ASSERT_EQ(mapped.size(), 3);
+    for (int id = 0; id < mapped.size(); id++) {
+        EXPECT_EQ(mapped.word(id), streamed.word(id));
+    }
+    EXPECT_EQ(mapped.find("red"), 2);
+    remove("test_mapped.txt");
+
+    Dictionary missing;
+    load_words_mapped(missing, "non_existent_file.txt");
+    EXPECT_TRUE(missing.empty());
+
+    // A missing file empties a dictionary that was already filled
+    load_words(streamed, "non_existent_file.txt");
+    load_words_mapped(mapped, "non_existent_file.txt");
+    EXPECT_TRUE(streamed.empty());
+    EXPECT_TRUE(mapped.empty());
+}
+
+TEST(Ladder, Ladder_Cache) {
+    std::set<std::string> word_list = {"cold", "gold", "golf", "wolf", "word", "wood", "wool", "world", "worlds"};
+    LadderIndex index(word_list);
+    write_ladder_cache(index, "test_words.ladder");
+
+    auto cache = LadderCache::open("test_words.ladder", index.dictionary());
+    ASSERT_NE(cache, nullptr);
+    LadderIndex cached(index.dictionary(), cache);
+    for (int id = 0; id < index.size(); id++) {
+        std::vector<int> expected, actual;
+        index.neighbors(id, expected);
+        cached.neighbors(id, actual);
+        EXPECT_EQ(actual, expected) << index.word(id);
+    }
+    EXPECT_EQ(generate_word_ladder("cold", "wolf", cached), generate_word_ladder("cold", "wolf", index));
+    // Begin word outside the dictionary falls back to a scan
+    EXPECT_EQ(generate_word_ladder("wore", "worlds", cached).size(), 4);
+
+    // A different dictionary makes the cache stale, and loading rebuilds it
+    word_list.insert("bold");
+    Dictionary changed(word_list);
+    EXPECT_EQ(LadderCache::open("test_words.ladder", changed), nullptr);
+    LadderIndex rebuilt = load_ladder_index(changed, "test_words.ladder");
+    EXPECT_EQ(generate_word_ladder("cold", "bold", rebuilt).size(), 2);
+    EXPECT_NE(LadderCache::open("test_words.ladder", changed), nullptr);
+
+    EXPECT_EQ(LadderCache::open("non_existent_file.ladder", changed), nullptr);
+    remove("test_words.ladder");
+}
+
+TEST(Ladder, Generate_Word_Ladders) {
+    std::set<std::string> word_list = {"cold", "gold", "golf", "wolf", "word", "wood", "wool", "world", "worlds"};
+    LadderIndex index(word_list);
+    std::vector<std::pair<std::string, std::string>> queries = {
+        {"cold", "wolf"}, {"cold", "cold"}, {"cold", "bold"}, {"wore", "worlds"}, {"gold", "word"}};
+
+    std::vector<LadderResult> results = generate_word_ladders(queries, index, 3);
+    ASSERT_EQ(results.size(), queries.size());
+    for (size_t i = 0; i < queries.size(); i++) {
+        LadderResult expected = find_word_ladder(queries[i].first, queries[i].second, index);
+        EXPECT_EQ(results[i].ladder, expected.ladder) << queries[i].first << " -> " << queries[i].second;
+        EXPECT_EQ(results[i].error, expected.error);
+    }
+    EXPECT_EQ(results[0].ladder.size(), 4);
+    EXPECT_EQ(results[1].error, "Start and end words are the same");
+    EXPECT_EQ(results[2].error, "End word not in dictionary");
+    EXPECT_EQ(results[4].error, "No word ladder exists");
+}
+
 // We'll test verify_word_ladder indirectly since it calls generate_word_ladder
 TEST(Ladder, Verify_Word_Ladder) {
     // Capture output to check if tests pass
@@ -237,6 +475,128 @@ TEST(Graph, File_to_Graph) {
     remove("test_graph.txt");
 }
 
+TEST(Graph, Parse_Graph) {
+    // The bulk parser matches the stream operator on a real file
+    std::ifstream in("largest.txt");
+    Graph streamed, parsed;
+    in >> streamed;
+    file_to_graph("largest.txt", parsed);
+    ASSERT_EQ(parsed.numVertices, streamed.numVertices);
+    for (int u = 0; u < parsed.numVertices; u++) {
+        ASSERT_EQ(parsed[u].size(), streamed[u].size());
+        for (size_t i = 0; i < parsed[u].size(); i++) {
+            EXPECT_EQ(parsed[u][i].dst, streamed[u][i].dst);
+            EXPECT_EQ(parsed[u][i].weight, streamed[u][i].weight);
+        }
+    }
+
+    CSRGraph csr;
+    parse_graph("3\n0 1 5\r\n0 2 10\t1 2 2\n", csr);
+    EXPECT_EQ(csr.numEdges(), 3);
+    EXPECT_EQ(std::vector<int>(csr.dst.begin(), csr.dst.end()), (std::vector<int>{1, 2, 2}));
+
+    // Malformed input and out-of-range vertices are rejected instead of corrupting memory
+    EXPECT_THROW(parse_graph("3\n0 1 5\n3 0 1\n", csr), std::runtime_error);
+    EXPECT_THROW(parse_graph("3\n0 -1 5\n", csr), std::runtime_error);
+    EXPECT_THROW(parse_graph("3\n0 1 5\n1 2\n", csr), std::runtime_error);
+    EXPECT_THROW(parse_graph("3\n0 1 5x\n", csr), std::runtime_error);
+    EXPECT_THROW(parse_graph("", csr), std::runtime_error);
+    EXPECT_THROW(file_to_graph("non_existent_file.txt", csr), std::runtime_error);
+
+    std::istringstream bad("2\n0 1 1\n5 0 1\n");
+    Graph G;
+    EXPECT_THROW(bad >> G, std::runtime_error);
+}
+
+TEST(Graph, Binary_Graph) {
+    CSRGraph text;
+    file_to_graph("largest.txt", text);
+    write_binary_graph(text, "test_graph.bin");
+
+    // The CSR arrays point straight into the mapped file
+    CSRGraph mapped;
+    file_to_graph("test_graph.bin", mapped);
+    ASSERT_EQ(mapped.numVertices, text.numVertices);
+    EXPECT_TRUE(std::equal(mapped.offsets.begin(), mapped.offsets.end(), text.offsets.begin(), text.offsets.end()));
+    EXPECT_TRUE(std::equal(mapped.dst.begin(), mapped.dst.end(), text.dst.begin(), text.dst.end()));
+    EXPECT_TRUE(std::equal(mapped.weight.begin(), mapped.weight.end(), text.weight.begin(), text.weight.end()));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped.dst.data()) % BINARY_GRAPH_ALIGNMENT, 0);
+    std::vector<int> previous, mapped_previous;
+    CSRGraph copy = mapped;   // Copies share the mapping
+    mapped = CSRGraph();
+    EXPECT_EQ(dijkstra_shortest_path(copy, 0, mapped_previous), dijkstra_shortest_path(text, 0, previous));
+
+    Graph lists;
+    file_to_graph("test_graph.bin", lists);
+    EXPECT_EQ(dijkstra_shortest_path(lists, 0, mapped_previous), dijkstra_shortest_path(text, 0, previous));
+
+    // Truncated files are rejected
+    std::filesystem::resize_file("test_graph.bin", std::filesystem::file_size("test_graph.bin") - 4);
+    EXPECT_THROW(file_to_graph("test_graph.bin", mapped), std::runtime_error);
+    remove("test_graph.bin");
+
+    // So are damaged arrays: offsets start one alignment block in (right after the
+    // header), dst one block after them for this three-vertex graph
+    auto damaged = [](std::streamoff at, int value) {
+        write_binary_graph(CSRGraph(3, {Edge(0, 1, 1), Edge(1, 2, 1), Edge(2, 0, 1)}), "test_graph.bin");
+        std::fstream file("test_graph.bin", std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(at);
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    damaged(BINARY_GRAPH_ALIGNMENT + sizeof(int), 3);          // offsets = {0, 3, 2, 3}
+    EXPECT_THROW(file_to_graph("test_graph.bin", mapped), std::runtime_error);
+    EXPECT_THROW(file_to_graph("test_graph.bin", lists), std::runtime_error);
+    damaged(2 * BINARY_GRAPH_ALIGNMENT + sizeof(int), 7);      // dst = {1, 7, 0}
+    EXPECT_THROW(file_to_graph("test_graph.bin", mapped), std::runtime_error);
+    damaged(2 * BINARY_GRAPH_ALIGNMENT, 2);                    // Still in range
+    file_to_graph("test_graph.bin", mapped);
+    EXPECT_EQ(mapped.dst[0], 2);
+    remove("test_graph.bin");
+
+    write_binary_graph(CSRGraph(), "test_graph.bin");
+    file_to_graph("test_graph.bin", mapped);
+    EXPECT_EQ(mapped.numVertices, 0);
+    remove("test_graph.bin");
+}
+
+TEST(Graph, Generators) {
+    CSRGraph grid = grid_graph(3, 4, 1);
+    EXPECT_EQ(grid.numVertices, 12);
+    EXPECT_EQ(grid.numEdges(), 2 * (3 * 3 + 2 * 4));
+    CSRGraph hubs = power_law_graph(1000, 2, 1);
+    EXPECT_EQ(hubs.numEdges(), 2 * (3 + 997 * 2));
+    int max_degree = 0;
+    for (int u = 0; u < hubs.numVertices; u++) max_degree = std::max(max_degree, hubs.offsets[u + 1] - hubs.offsets[u]);
+    EXPECT_GT(max_degree, 40);
+    CSRGraph random = random_graph(100, 3, 7, 10);
+    EXPECT_EQ(random.numEdges(), 300);
+    EXPECT_TRUE(std::all_of(random.weight.begin(), random.weight.end(), [](int w) { return w >= 1 && w <= 10; }));
+    EXPECT_TRUE(std::equal(random.dst.begin(), random.dst.end(), random_graph(100, 3, 7, 10).dst.begin()));
+
+    // Text files read back as the same graph
+    write_text_graph(grid, "test_graph.txt");
+    CSRGraph read;
+    file_to_graph("test_graph.txt", read);
+    remove("test_graph.txt");
+    EXPECT_TRUE(std::equal(read.offsets.begin(), read.offsets.end(), grid.offsets.begin(), grid.offsets.end()));
+    EXPECT_TRUE(std::equal(read.dst.begin(), read.dst.end(), grid.dst.begin(), grid.dst.end()));
+    EXPECT_TRUE(std::equal(read.weight.begin(), read.weight.end(), grid.weight.begin(), grid.weight.end()));
+
+    // Synthetic words are distinct and all connected by ladders
+    std::vector<std::string> words = synthetic_words(500, 3);
+    ASSERT_EQ(words.size(), 500);
+    std::set<std::string> word_list(words.begin(), words.end());
+    EXPECT_EQ(word_list.size(), 500);
+    LadderIndex index(word_list);
+    EXPECT_FALSE(generate_word_ladder(words.front(), words.back(), index).empty());
+    EXPECT_FALSE(generate_word_ladder(words[100], words[400], index).empty());
+
+    // Every two-letter word fits, but not one more, and nothing fits below two letters
+    EXPECT_EQ(synthetic_words(26 * 26, 3, 2).size(), 26 * 26);
+    EXPECT_THROW(synthetic_words(26 * 26 + 1, 3, 2), std::runtime_error);
+    EXPECT_THROW(synthetic_words(1, 3, 1), std::runtime_error);
+}
+
 TEST(Dijkstras, Dijkstra_Shortest_Path) {
     Graph G = createTestGraph();
     std::vector<int> previous;
@@ -259,6 +619,479 @@ TEST(Dijkstras, Dijkstra_Shortest_Path) {
     EXPECT_EQ(previous[3], 2);  // Previous of 3 is 2
 }
 
+TEST(Dijkstras, Dijkstra_Stats) {
+    if (!STATS_ENABLED) GTEST_SKIP() << "Built with HW9_STATS=0";
+    Graph G = createTestGraph();
+    std::vector<int> previous;
+    DijkstraStats stats;
+
+    // 2 and 3 are each pushed again at a lower distance, leaving two stale entries
+    EXPECT_EQ(dijkstra_shortest_path(G, 0, previous, stats), dijkstra_shortest_path(G, 0, previous));
+    EXPECT_EQ(stats.heap_pushes, 6);
+    EXPECT_EQ(stats.stale_pops, 2);
+    EXPECT_EQ(stats.relaxations, 5);
+    EXPECT_EQ(stats.settled, 4);
+
+    // The indexed heap decreases keys in place instead
+    dijkstra_shortest_path(CSRGraph(G), 0, previous, stats, DijkstraQueue::IndexedDary);
+    EXPECT_EQ(stats.heap_pushes, 6);
+    EXPECT_EQ(stats.stale_pops, 0);
+    EXPECT_EQ(stats.settled, 4);
+
+    // Point-to-point queries stop early
+    ShortestPath result = shortest_path(G, 0, 1, stats);
+    EXPECT_EQ(result.distance, 1);
+    EXPECT_EQ(stats.settled, 2);
+    EXPECT_EQ(result.settled, 2);
+    EXPECT_EQ(stats.relaxations, 2);
+    EXPECT_EQ(to_json(stats), "{\"heap_pushes\": 3, \"stale_pops\": 0, \"relaxations\": 2, \"settled\": 2}");
+}
+
+TEST(Dijkstras, CSR_Graph) {
+    Graph G = createTestGraph();
+    CSRGraph csr(G);
+    EXPECT_EQ(csr.numVertices, 4);
+    EXPECT_EQ(csr.numEdges(), 5);
+    EXPECT_EQ(std::vector<int>(csr.offsets.begin(), csr.offsets.end()), (std::vector<int>{0, 2, 4, 5, 5}));
+    EXPECT_EQ(std::vector<int>(csr.dst.begin(), csr.dst.end()), (std::vector<int>{1, 2, 2, 3, 3}));
+    EXPECT_EQ(std::vector<int>(csr.weight.begin(), csr.weight.end()), (std::vector<int>{1, 4, 2, 6, 3}));
+
+    std::vector<int> previous, csr_previous;
+    EXPECT_EQ(dijkstra_shortest_path(csr, 0, csr_previous), dijkstra_shortest_path(G, 0, previous));
+    EXPECT_EQ(csr_previous, previous);
+
+    // Reading the text format straight into CSR gives the same answers
+    for (const char* file : {"small.txt", "medium.txt", "large.txt", "largest.txt"}) {
+        Graph text;
+        CSRGraph packed;
+        file_to_graph(file, text);
+        file_to_graph(file, packed);
+        ASSERT_EQ(packed.numVertices, text.numVertices) << file;
+        EXPECT_EQ(dijkstra_shortest_path(packed, 0, csr_previous), dijkstra_shortest_path(text, 0, previous)) << file;
+        EXPECT_EQ(csr_previous, previous) << file;
+    }
+}
+
+// Helper function to create a random graph with small integer weights
+CSRGraph createRandomGraph(int numVertices, int numEdges, int maxWeight, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<Edge> edges;
+    for (int i = 0; i < numEdges; i++) {
+        edges.emplace_back(rng() % numVertices, rng() % numVertices, rng() % (maxWeight + 1));
+    }
+    return CSRGraph(numVertices, edges);
+}
+
+TEST(Dijkstras, Indexed_Dary_Heap) {
+    IndexedDaryHeap<4> heap(6);
+    heap.push(3, 30);
+    heap.push(1, 10);
+    heap.push(5, 50);
+    heap.push(4, 40);
+    heap.push(5, 5);     // Decrease-key keeps one entry per vertex
+    EXPECT_EQ(heap.size(), 4);
+    EXPECT_EQ(heap.pop(), 5);
+    EXPECT_EQ(heap.pop(), 1);
+    EXPECT_FALSE(heap.contains(1));
+    EXPECT_EQ(heap.pop(), 3);
+    EXPECT_EQ(heap.pop(), 4);
+    EXPECT_TRUE(heap.empty());
+
+    // Same distances and shortest-path tree as the lazy binary heap
+    for (unsigned seed = 1; seed <= 5; seed++) {
+        CSRGraph G = createRandomGraph(300, 1500, 20, seed);
+        std::vector<int> lazy_previous, indexed_previous;
+        EXPECT_EQ(dijkstra_shortest_path(G, 0, indexed_previous, DijkstraQueue::IndexedDary),
+                  dijkstra_shortest_path(G, 0, lazy_previous, DijkstraQueue::LazyBinary));
+        EXPECT_EQ(indexed_previous, lazy_previous);
+    }
+}
+
+TEST(Dijkstras, Monotone_Queues) {
+    RadixHeap radix(4);
+    radix.push(0, 7);
+    radix.push(1, 3);
+    radix.push(2, 1000000);
+    EXPECT_EQ(radix.pop(), 1);
+    radix.push(3, 3);    // Equal to the last popped key
+    EXPECT_EQ(radix.pop(), 3);
+    EXPECT_EQ(radix.pop(), 0);
+    EXPECT_EQ(radix.pop(), 2);
+    EXPECT_TRUE(radix.empty());
+
+    // Equal-distance vertices may settle in another order, so compare distances only
+    for (unsigned seed = 1; seed <= 5; seed++) {
+        for (int maxWeight : {1, 20, 5000}) {
+            CSRGraph G = createRandomGraph(300, 1500, maxWeight, seed);
+            std::vector<int> previous;
+            std::vector<int> expected = dijkstra_shortest_path(G, 0, previous, DijkstraQueue::LazyBinary);
+            for (DijkstraQueue queue : {DijkstraQueue::Radix, DijkstraQueue::Dial, DijkstraQueue::Auto}) {
+                std::vector<int> distances = dijkstra_shortest_path(G, 0, previous, queue);
+                EXPECT_EQ(distances, expected);
+                // Every tree edge must be an edge of G that is tight under the distances
+                for (int v = 1; v < G.numVertices; v++) {
+                    if (distances[v] == INF) continue;
+                    int u = previous[v];
+                    bool tight = false;
+                    for (int i = G.offsets[u]; i < G.offsets[u + 1]; i++) {
+                        tight |= G.dst[i] == v && distances[u] + G.weight[i] == distances[v];
+                    }
+                    EXPECT_TRUE(tight);
+                }
+            }
+        }
+    }
+
+    Graph negative;
+    negative.numVertices = 2;
+    negative.resize(2);
+    negative[0].push_back(Edge(0, 1, -1));
+    std::vector<int> previous;
+    EXPECT_THROW(dijkstra_shortest_path(negative, 0, previous, DijkstraQueue::Radix), std::runtime_error);
+    EXPECT_EQ(dijkstra_shortest_path(negative, 0, previous, DijkstraQueue::Auto)[1], -1);
+}
+
+TEST(Dijkstras, Shortest_Path) {
+    Graph G = createTestGraph();
+    ShortestPath result = shortest_path(G, 0, 2);
+    EXPECT_EQ(result.distance, 3);
+    EXPECT_EQ(result.path, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(result.settled, 3);    // Stops before settling vertex 3
+    EXPECT_EQ(shortest_path(G, 3, 0).distance, INF);
+    EXPECT_TRUE(shortest_path(G, 3, 0).path.empty());
+    EXPECT_THROW(shortest_path(G, 0, 4), std::runtime_error);
+
+    // Weights up to a million make ties unlikely, so paths agree too
+    for (unsigned seed = 1; seed <= 5; seed++) {
+        CSRGraph csr = createRandomGraph(300, 1200, 1000000, seed);
+        CSRGraph reversed = reverse_graph(csr);
+        std::vector<int> previous;
+        std::vector<int> distances = dijkstra_shortest_path(csr, 0, previous);
+        for (int target = 0; target < csr.numVertices; target += 7) {
+            std::vector<int> expected = extract_shortest_path(distances, previous, target);
+            ShortestPath early = shortest_path(csr, 0, target);
+            EXPECT_EQ(early.distance, distances[target]);
+            EXPECT_EQ(early.path, expected);
+            ShortestPath both = bidirectional_shortest_path(csr, reversed, 0, target);
+            EXPECT_EQ(both.distance, distances[target]);
+            EXPECT_EQ(both.path, expected);
+        }
+    }
+
+    // With many ties only the distance is pinned down
+    CSRGraph csr = createRandomGraph(300, 1500, 3, 9);
+    std::vector<int> previous;
+    std::vector<int> distances = dijkstra_shortest_path(csr, 5, previous);
+    for (int target = 0; target < csr.numVertices; target++) {
+        EXPECT_EQ(bidirectional_shortest_path(csr, 5, target).distance, distances[target]);
+    }
+}
+
+TEST(Dijkstras, Contraction_Hierarchy) {
+    ContractionHierarchy small(createTestGraph());
+    EXPECT_EQ(small.query(0, 3).distance, 6);
+    EXPECT_EQ(small.query(0, 3).path, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(small.query(2, 2).path, (std::vector<int>{2}));
+    EXPECT_EQ(small.query(3, 0).distance, INF);
+    EXPECT_TRUE(small.query(3, 0).path.empty());
+
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        CSRGraph G = createRandomGraph(400, 1600, 1000000, seed);
+        ContractionHierarchy hierarchy(G);
+        EXPECT_GT(hierarchy.shortcut_count(), 0);
+        for (int source = 0; source < G.numVertices; source += 37) {
+            std::vector<int> previous;
+            std::vector<int> distances = dijkstra_shortest_path(G, source, previous);
+            for (int target = 0; target < G.numVertices; target++) {
+                ShortestPath result = hierarchy.query(source, target);
+                EXPECT_EQ(result.distance, distances[target]) << source << " -> " << target;
+                EXPECT_EQ(result.path, extract_shortest_path(distances, previous, target)) << source << " -> " << target;
+            }
+        }
+    }
+
+    // Saved hierarchies answer the same way and are rejected for a different graph
+    CSRGraph G = createRandomGraph(200, 800, 10, 4);
+    auto built = load_contraction_hierarchy(G, "test_graph.ch");
+    auto loaded = ContractionHierarchy::open("test_graph.ch", G);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->shortcut_count(), built->shortcut_count());
+    for (int target = 0; target < G.numVertices; target++) {
+        EXPECT_EQ(loaded->query(3, target).path, built->query(3, target).path);
+    }
+    EXPECT_EQ(ContractionHierarchy::open("test_graph.ch", createRandomGraph(200, 800, 10, 5)), nullptr);
+    EXPECT_EQ(ContractionHierarchy::open("non_existent_file.ch", G), nullptr);
+    remove("test_graph.ch");
+}
+
+TEST(Dijkstras, ALT_Shortest_Path) {
+    CSRGraph G = createRandomGraph(400, 1600, 1000, 6);
+    Landmarks landmarks(G, 8);
+    EXPECT_EQ(landmarks.count(), 8);
+    int dijkstra_settled = 0, alt_settled = 0;
+    for (int source = 0; source < G.numVertices; source += 41) {
+        std::vector<int> previous;
+        std::vector<int> distances = dijkstra_shortest_path(G, source, previous);
+        for (int target = 0; target < G.numVertices; target += 3) {
+            // The bounds must never overestimate
+            EXPECT_LE(landmarks.lower_bound(source, target), distances[target]);
+            ShortestPath result = alt_shortest_path(G, landmarks, source, target);
+            ASSERT_EQ(result.distance, distances[target]) << source << " -> " << target;
+            if (result.distance != INF) {
+                int length = 0;
+                for (size_t i = 1; i < result.path.size(); i++) {
+                    int best = INF;
+                    for (int e = G.offsets[result.path[i - 1]]; e < G.offsets[result.path[i - 1] + 1]; e++) {
+                        if (G.dst[e] == result.path[i]) best = std::min(best, G.weight[e]);
+                    }
+                    ASSERT_NE(best, INF);
+                    length += best;
+                }
+                EXPECT_EQ(length, result.distance);
+                dijkstra_settled += shortest_path(G, source, target).settled;
+                alt_settled += result.settled;
+            }
+        }
+    }
+    EXPECT_LT(alt_settled, dijkstra_settled);
+
+    // No landmarks is plain Dijkstra
+    EXPECT_EQ(alt_shortest_path(G, Landmarks(G, 0), 3, 9).settled, shortest_path(G, 3, 9).settled);
+}
+
+TEST(Dijkstras, Dijkstra_Batch) {
+    CSRGraph G = createRandomGraph(300, 1200, 50, 7);
+    std::vector<int> sources = {5, 0, 299, 5, 42, 17, 100};
+    std::vector<size_t> order;
+    dijkstra_batch(G, sources, [&](size_t i, const std::vector<int>& distances, const std::vector<int>& previous) {
+        order.push_back(i);
+        std::vector<int> expected_previous;
+        EXPECT_EQ(distances, dijkstra_shortest_path(G, sources[i], expected_previous));
+        EXPECT_EQ(previous, expected_previous);
+    }, 3);
+    EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2, 3, 4, 5, 6}));
+
+    // One workspace reused across graphs of different sizes
+    DijkstraWorkspace workspace;
+    Graph small = createTestGraph();
+    workspace.run(small, 0);
+    EXPECT_EQ(workspace.distances(), (std::vector<int>{0, 1, 3, 6}));
+    workspace.run(G, 8);
+    std::vector<int> previous;
+    EXPECT_EQ(workspace.distances(), dijkstra_shortest_path(G, 8, previous));
+
+    // Bad sources and failing visitors surface as exceptions
+    EXPECT_THROW(dijkstra_batch(G, {0, 300}, [](size_t, const std::vector<int>&, const std::vector<int>&) {}, 2),
+                 std::runtime_error);
+    int visited = 0;
+    EXPECT_THROW(dijkstra_batch(G, sources, [&](size_t i, const std::vector<int>&, const std::vector<int>&) {
+        visited++;
+        if (i == 2) throw std::runtime_error("stop");
+    }, 3), std::runtime_error);
+    EXPECT_EQ(visited, 3);
+}
+
+TEST(Dijkstras, Delta_Stepping) {
+    // Weight 0 edges and ties included; previous only needs to be a shortest-path tree
+    for (unsigned seed = 1; seed <= 4; seed++) {
+        CSRGraph G = createRandomGraph(500, 2500, 30, seed);
+        std::vector<int> expected_previous;
+        std::vector<int> expected = dijkstra_shortest_path(G, 0, expected_previous);
+        for (int delta : {0, 1, 7, 100}) {
+            for (unsigned threads : {1u, 4u}) {
+                std::vector<int> previous;
+                EXPECT_EQ(delta_stepping_shortest_path(G, 0, previous, {delta, threads}), expected);
+                for (int v = 0; v < G.numVertices; v++) {
+                    if (v == 0 || expected[v] == INF) {
+                        EXPECT_EQ(previous[v], -1);
+                        continue;
+                    }
+                    int u = previous[v];
+                    bool tight = false;
+                    for (int i = G.offsets[u]; i < G.offsets[u + 1]; i++) {
+                        tight |= G.dst[i] == v && expected[u] + G.weight[i] == expected[v];
+                    }
+                    EXPECT_TRUE(tight);
+                    EXPECT_FALSE(extract_shortest_path(expected, previous, v).empty());
+                }
+            }
+        }
+    }
+    EXPECT_GE(tune_delta(createRandomGraph(100, 400, 30, 1)), 1);
+
+    // A huge weight with delta 1 lands far past the bucket ring instead of sizing it
+    CSRGraph far(4, {Edge(0, 1, 1000000000), Edge(0, 2, 3), Edge(2, 3, 1), Edge(3, 1, 999999990)});
+    std::vector<int> previous;
+    EXPECT_EQ(delta_stepping_shortest_path(far, 0, previous, {1, 1}), (std::vector<int>{0, 999999994, 3, 4}));
+    EXPECT_EQ(previous[1], 3);
+}
+
+TEST(Dijkstras, Dynamic_Shortest_Paths) {
+    // Small weights give plenty of ties and zero-weight edges
+    CSRGraph start = createRandomGraph(200, 700, 8, 11);
+    DynamicShortestPaths dynamic(start, 0);
+    std::mt19937 rng(12);
+    for (int step = 0; step < 400; step++) {
+        int u = rng() % 200, v = rng() % 200, w = rng() % 9;
+        switch (rng() % 3) {
+            case 0: dynamic.insert_edge(u, v, w); break;
+            case 1: dynamic.set_weight(u, v, w); break;
+            case 2: {
+                // Usually pick a tree edge, since those are the deletions that matter
+                int x = rng() % 200;
+                if (dynamic.previous()[x] >= 0) dynamic.remove_edge(dynamic.previous()[x], x);
+                else dynamic.remove_edge(u, v);
+                break;
+            }
+        }
+
+        CSRGraph G = dynamic.graph();
+        std::vector<int> previous;
+        std::vector<int> expected = dijkstra_shortest_path(G, 0, previous);
+        ASSERT_EQ(dynamic.distances(), expected) << "step " << step;
+        for (int x = 0; x < G.numVertices; x++) {
+            int p = dynamic.previous()[x];
+            if (x == 0 || expected[x] == INF) {
+                ASSERT_EQ(p, -1);
+                continue;
+            }
+            bool tight = false;
+            for (int e = G.offsets[p]; e < G.offsets[p + 1]; e++) {
+                tight |= G.dst[e] == x && expected[p] + G.weight[e] == expected[x];
+            }
+            ASSERT_TRUE(tight) << "step " << step << ", vertex " << x;
+        }
+    }
+
+    // Only the affected vertices are settled again
+    Graph chain;
+    chain.numVertices = 5;
+    chain.resize(5);
+    for (int u = 0; u < 4; u++) chain[u].push_back(Edge(u, u + 1, 1));
+    DynamicShortestPaths path(chain, 0);
+    path.set_weight(2, 3, 5);
+    EXPECT_EQ(path.distances(), (std::vector<int>{0, 1, 2, 7, 8}));
+    EXPECT_EQ(path.last_settled(), 2);
+    path.remove_edge(0, 1);
+    EXPECT_EQ(path.distances(), (std::vector<int>{0, INF, INF, INF, INF}));
+    EXPECT_EQ(path.last_settled(), 0);
+    path.insert_edge(0, 3, 1);
+    EXPECT_EQ(path.distances(), (std::vector<int>{0, INF, INF, 1, 2}));
+    EXPECT_EQ(path.last_settled(), 2);
+    EXPECT_THROW(path.insert_edge(0, 5, 1), std::runtime_error);
+    EXPECT_THROW(path.insert_edge(0, 1, -1), std::runtime_error);
+}
+
+TEST(Dijkstras, Write_Shortest_Paths) {
+    Graph G = createTestGraph();
+    G.numVertices = 5;
+    G.resize(5);   // Vertex 4 is unreachable
+    std::vector<int> previous;
+    std::vector<int> distances = dijkstra_shortest_path(G, 0, previous);
+
+    std::ostringstream paths;
+    write_shortest_paths(paths, distances, previous, {3, 4, 0});
+    EXPECT_EQ(paths.str(), "To vertex 3: 0 1 2 3 \nTotal cost is 6\n"
+                           "To vertex 4: No path exists\n"
+                           "To vertex 0: 0 \nTotal cost is 0\n");
+
+    std::ostringstream tree;
+    write_shortest_path_tree(tree, distances, previous);
+    EXPECT_EQ(tree.str(), "0 -1 0\n1 0 1\n2 1 3\n3 2 6\n4 -1 -\n");
+
+    // Out-of-range destinations are rejected before anything is written
+    std::ostringstream rejected;
+    EXPECT_THROW(write_shortest_paths(rejected, distances, previous, {1, 5}), std::runtime_error);
+    EXPECT_TRUE(rejected.str().empty());
+
+    // So are sources, before the search touches the arrays
+    EXPECT_THROW(dijkstra_shortest_path(G, 5, previous), std::runtime_error);
+    EXPECT_THROW(dijkstra_shortest_path(CSRGraph(G), -1, previous, DijkstraQueue::Dial), std::runtime_error);
+}
+
+TEST(Dijkstras, Weight_Types) {
+    // Fractional weights: the path through 1 wins only by the fractions
+    BasicGraph<double> fractional;
+    parse_graph("3\n0 1 0.25\n1 2 0.5\n0 2 0.8\n", fractional);
+    std::vector<int> previous;
+    std::vector<double> distances = dijkstra_shortest_path(fractional, 0, previous);
+    EXPECT_DOUBLE_EQ(distances[2], 0.75);
+    EXPECT_EQ(extract_shortest_path(distances, previous, 2), (std::vector<int>{0, 1, 2}));
+    BasicCSRGraph<float> packed(3, {{0, 1, 0.25f}, {1, 2, 0.5f}, {0, 2, 0.8f}});
+    EXPECT_EQ(packed.weight.size_bytes(), 3 * sizeof(float));
+    std::vector<float> single = dijkstra_shortest_path(packed, 0, previous, DijkstraQueue::IndexedDary);
+    EXPECT_FLOAT_EQ(single[2], 0.75f);
+    EXPECT_THROW(dijkstra_shortest_path(packed, 0, previous, DijkstraQueue::Radix), std::runtime_error);
+
+    // Two edges of 2e9 overflow int but not int64_t
+    Graph narrow;
+    narrow.numVertices = 4;
+    narrow.resize(4);
+    narrow[0].push_back(Edge(0, 1, 2000000000));
+    narrow[1].push_back(Edge(1, 2, 2000000000));
+    EXPECT_THROW(dijkstra_shortest_path(narrow, 0, previous), std::runtime_error);
+    EXPECT_THROW(dijkstra_shortest_path(CSRGraph(narrow), 0, previous, DijkstraQueue::Radix), std::runtime_error);
+
+    // An overflowing sum on a path that isn't shortest is just not taken
+    const int big = std::numeric_limits<int>::max();
+    CSRGraph detour(3, {Edge(0, 1, big - 10), Edge(0, 2, big - 5), Edge(1, 2, 100)});
+    for (DijkstraQueue queue : {DijkstraQueue::LazyBinary, DijkstraQueue::IndexedDary, DijkstraQueue::Radix}) {
+        EXPECT_EQ(dijkstra_shortest_path(detour, 0, previous, queue), (std::vector<int>{0, big - 10, big - 5}));
+        EXPECT_EQ(previous[2], 0);
+    }
+    // Every other search skips them the same way and agrees with shortest_path
+    ShortestPath reference = shortest_path(detour, 0, 2);
+    EXPECT_EQ(reference.distance, big - 5);
+    EXPECT_EQ(bidirectional_shortest_path(detour, 0, 2).distance, reference.distance);
+    EXPECT_EQ(alt_shortest_path(detour, Landmarks(detour, 2), 0, 2).distance, reference.distance);
+    EXPECT_EQ(ContractionHierarchy(detour).query(0, 2).distance, reference.distance);
+    EXPECT_EQ(delta_stepping_shortest_path(detour, 0, previous, {1000, 2})[2], reference.distance);
+    DynamicShortestPaths dynamic(CSRGraph(3, {Edge(0, 1, big - 10), Edge(0, 2, big - 5)}), 0);
+    dynamic.insert_edge(1, 2, 100);
+    EXPECT_EQ(dynamic.distances()[2], reference.distance);
+
+    // A target only reachable past the overflow has no int distance; one that isn't
+    // behind it is still answered
+    CSRGraph beyond = CSRGraph(narrow);
+    EXPECT_THROW(shortest_path(beyond, 0, 2), std::runtime_error);
+    EXPECT_THROW(bidirectional_shortest_path(beyond, 0, 2), std::runtime_error);
+    EXPECT_THROW(alt_shortest_path(beyond, Landmarks(beyond, 0), 0, 2), std::runtime_error);
+    EXPECT_THROW(delta_stepping_shortest_path(beyond, 0, previous), std::runtime_error);
+    EXPECT_EQ(shortest_path(beyond, 0, 3).distance, INF);
+    EXPECT_EQ(ContractionHierarchy(beyond).query(0, 2).distance, INF);
+    DynamicShortestPaths growing(CSRGraph(3, {Edge(0, 1, 2000000000)}), 0);
+    EXPECT_THROW(growing.insert_edge(1, 2, 2000000000), std::runtime_error);
+
+    BasicCSRGraph<double> far(3, {{0, 1, 1e308}, {1, 2, 1e308}, {0, 2, 1.5e308}});
+    EXPECT_EQ(dijkstra_shortest_path(far, 0, previous)[2], 1.5e308);
+    BasicCSRGraph<double> too_far(3, {{0, 1, 1e308}, {1, 2, 1e308}});
+    EXPECT_THROW(dijkstra_shortest_path(too_far, 0, previous), std::runtime_error);
+    BasicGraph<int64_t> wide;
+    wide.numVertices = 4;
+    wide.resize(4);
+    for (int u = 0; u < 2; u++) {
+        for (const Edge& e : narrow[u]) wide[u].push_back({e.src, e.dst, e.weight});
+    }
+    std::vector<int64_t> long_distances = dijkstra_shortest_path(BasicCSRGraph<int64_t>(wide), 0, previous);
+    EXPECT_EQ(long_distances[2], 4000000000LL);
+    EXPECT_EQ(long_distances[3], INF_WEIGHT<int64_t>);
+    EXPECT_TRUE(extract_shortest_path(long_distances, previous, 3).empty());
+
+    // Binary graph files hold int weights, widened on the way in
+    CSRGraph small;
+    file_to_graph("small.txt", small);
+    write_binary_graph(small, "test_weights.bin");
+    BasicCSRGraph<double> widened;
+    file_to_graph("test_weights.bin", widened);
+    remove("test_weights.bin");
+    std::vector<int> int_previous;
+    std::vector<int> expected = dijkstra_shortest_path(small, 0, int_previous);
+    std::vector<double> actual = dijkstra_shortest_path(widened, 0, previous);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t v = 0; v < expected.size(); v++) EXPECT_EQ(actual[v], expected[v]) << "vertex " << v;
+    EXPECT_EQ(previous, int_previous);
+}
+
 TEST(Dijkstras, Extract_Shortest_Path) {
     // Test case with a valid path
     std::vector<int> distances = {0, 1, 3, 6};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+// Writes file_name in binary through write, first to file_name + ".tmp" and then by a
+// rename, so readers that open or map the file never see it half-written. On failure
+// the temporary file is removed and runtime_error names the file as a `kind` file.
+inline void write_file_atomically(const string& file_name, const string& kind, const function<void(ofstream&)>& write) {
+    string temp_name = file_name + ".tmp";
+    ofstream out(temp_name, ios::binary | ios::trunc);
+    if (!out) {
+        throw runtime_error("Can't open " + kind + " file " + temp_name);
+    }
+    write(out);
+    out.close();
+    if (!out || rename(temp_name.c_str(), file_name.c_str()) != 0) {
+        remove(temp_name.c_str());
+        throw runtime_error("Can't write " + kind + " file " + file_name);
+    }
+}
@@ -0,0 +1,212 @@
+#include "dijkstras.h"
+#include "generators.h"
+#include "ladder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+struct BenchmarkOptions {
+    int runs = 7;              // Timed runs per row, after one untimed warm-up run
+    int max_size = 100000;     // Largest vertex or word count
+    bool csv = false;          // CSV with a header line instead of one JSON object per line
+    string only;               // "graphs" or "words" to run one suite
+};
+
+struct Timing {
+    double min = 0, median = 0, mean = 0, stddev = 0;
+};
+
+// One warm-up run, then options.runs timed ones
+static Timing time_runs(int runs, const function<void()>& run) {
+    run();
+    vector<double> times;
+    for (int i = 0; i < runs; ++i) {
+        auto start = chrono::steady_clock::now();
+        run();
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    sort(times.begin(), times.end());
+    Timing timing;
+    timing.min = times.front();
+    timing.median = runs % 2 ? times[runs / 2] : (times[runs / 2 - 1] + times[runs / 2]) / 2;
+    for (double t : times) timing.mean += t / runs;
+    for (double t : times) timing.stddev += (t - timing.mean) * (t - timing.mean) / max(1, runs - 1);
+    timing.stddev = sqrt(timing.stddev);
+    return timing;
+}
+
+// Writes one row per measurement: the function timed, the input family, its size
+// (vertices or words), the work per run (edges or queries) and the run statistics
+class Report {
+public:
+    explicit Report(const BenchmarkOptions& options) : options(options) {
+        cout << fixed << setprecision(4);
+        if (options.csv) cout << "benchmark,input,size,work,runs,min_ms,median_ms,mean_ms,stddev_ms\n";
+    }
+
+    void row(const string& benchmark, const string& input, long size, long work, const Timing& t) {
+        if (options.csv) {
+            cout << benchmark << ',' << input << ',' << size << ',' << work << ',' << options.runs << ',' << t.min
+                 << ',' << t.median << ',' << t.mean << ',' << t.stddev << '\n';
+        } else {
+            cout << "{\"benchmark\": \"" << benchmark << "\", \"input\": \"" << input << "\", \"size\": " << size
+                 << ", \"work\": " << work << ", \"runs\": " << options.runs << ", \"min_ms\": " << t.min
+                 << ", \"median_ms\": " << t.median << ", \"mean_ms\": " << t.mean << ", \"stddev_ms\": " << t.stddev
+                 << "}\n";
+        }
+        cout.flush();
+    }
+
+private:
+    const BenchmarkOptions& options;
+};
+
+static vector<int> sizes_up_to(int max_size) {
+    vector<int> sizes;
+    for (int size = 1000; size <= max_size; size *= 10) sizes.push_back(size);
+    return sizes;
+}
+
+static CSRGraph make_graph(const string& family, int numVertices, unsigned seed) {
+    if (family == "random") return random_graph(numVertices, 4, seed);
+    if (family == "grid") {
+        int side = max(1, int(sqrt(double(numVertices))));
+        return grid_graph(side, side, seed);
+    }
+    if (family == "power-law") return power_law_graph(numVertices, 2, seed);
+    throw runtime_error("Unknown graph family " + family + " (expected random, grid or power-law)");
+}
+
+// file_to_graph on the text and binary formats, then dijkstra_shortest_path from
+// vertex 0 on both graph representations
+static void bench_graphs(const BenchmarkOptions& options, const filesystem::path& dir, Report& report) {
+    volatile int sink = 0;
+    for (int size : sizes_up_to(options.max_size)) {
+        for (const string family : {"random", "grid", "power-law"}) {
+            CSRGraph generated = make_graph(family, size, size);
+            string text_file = dir / (family + ".txt"), binary_file = dir / (family + ".bin");
+            write_text_graph(generated, text_file);
+            write_binary_graph(generated, binary_file);
+            long n = generated.numVertices, m = generated.numEdges();
+
+            Graph list;
+            CSRGraph csr;
+            report.row("file_to_graph/list", family, n, m, time_runs(options.runs, [&] {
+                list = Graph();
+                file_to_graph(text_file, list);
+            }));
+            report.row("file_to_graph/csr", family, n, m, time_runs(options.runs, [&] {
+                file_to_graph(text_file, csr);
+            }));
+            report.row("file_to_graph/binary", family, n, m, time_runs(options.runs, [&] {
+                CSRGraph mapped;
+                file_to_graph(binary_file, mapped);
+                sink = sink + mapped.dst.back();
+            }));
+
+            vector<int> previous;
+            report.row("dijkstra_shortest_path/list", family, n, m, time_runs(options.runs, [&] {
+                sink = sink + dijkstra_shortest_path(list, 0, previous).back();
+            }));
+            report.row("dijkstra_shortest_path/csr", family, n, m, time_runs(options.runs, [&] {
+                sink = sink + dijkstra_shortest_path(csr, 0, previous).back();
+            }));
+        }
+    }
+}
+
+// load_words, then generate_word_ladder for a fixed set of random word pairs on an
+// index built once
+static void bench_words(const BenchmarkOptions& options, const filesystem::path& dir, Report& report) {
+    const int queries = 20;
+    volatile size_t sink = 0;
+    for (int size : sizes_up_to(options.max_size)) {
+        vector<string> words = synthetic_words(size, size);
+        string words_file = dir / "words.txt";
+        write_words(words, words_file);
+
+        set<string> word_list;
+        report.row("load_words", "synthetic", size, size, time_runs(options.runs, [&] {
+            word_list.clear();
+            load_words(word_list, words_file);
+        }));
+
+        mt19937 rng(size);
+        uniform_int_distribution<size_t> pick(0, words.size() - 1);
+        vector<pair<string, string>> pairs;
+        while (int(pairs.size()) < queries) {
+            const string& begin_word = words[pick(rng)];
+            const string& end_word = words[pick(rng)];
+            if (begin_word != end_word) pairs.emplace_back(begin_word, end_word);
+        }
+        LadderIndex index(word_list);
+        report.row("generate_word_ladder", "synthetic", size, queries, time_runs(options.runs, [&] {
+            for (const auto& [begin_word, end_word] : pairs) {
+                sink = sink + generate_word_ladder(begin_word, end_word, index).size();
+            }
+        }));
+    }
+}
+
+static int run_benchmarks(const BenchmarkOptions& options) {
+    filesystem::path dir = filesystem::temp_directory_path() / ("hw9-benchmarks-" + to_string(getpid()));
+    filesystem::create_directories(dir);
+    try {
+        Report report(options);
+        if (options.only.empty() || options.only == "graphs") bench_graphs(options, dir, report);
+        if (options.only.empty() || options.only == "words") bench_words(options, dir, report);
+    } catch (...) {
+        filesystem::remove_all(dir);
+        throw;
+    }
+    filesystem::remove_all(dir);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        string mode = argc > 1 ? argv[1] : "";
+        if ((argc == 5 || argc == 6) && mode == "--graph") {
+            CSRGraph G = make_graph(argv[2], stoi(argv[3]), argc > 5 ? stoul(argv[5]) : 1);
+            write_text_graph(G, argv[4]);
+            cout << "Wrote " << G.numVertices << " vertices and " << G.numEdges() << " edges to " << argv[4] << endl;
+            return 0;
+        }
+        if ((argc == 4 || argc == 5) && mode == "--words") {
+            vector<string> words = synthetic_words(stoi(argv[2]), argc > 4 ? stoul(argv[4]) : 1);
+            write_words(words, argv[3]);
+            cout << "Wrote " << words.size() << " words to " << argv[3] << endl;
+            return 0;
+        }
+
+        BenchmarkOptions options;
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--csv") {
+                options.csv = true;
+            } else if (arg == "--runs" && i + 1 < argc) {
+                options.runs = max(1, stoi(argv[++i]));
+            } else if (arg == "--max-size" && i + 1 < argc) {
+                options.max_size = stoi(argv[++i]);
+            } else if (arg == "--only" && i + 1 < argc && (string(argv[i + 1]) == "graphs" || string(argv[i + 1]) == "words")) {
+                options.only = argv[++i];
+            } else {
+                cerr << "Usage: " << argv[0] << " [--runs N] [--max-size N] [--csv] [--only graphs|words]"
+                     << " | --graph random|grid|power-law <vertices> <file> [seed] | --words <count> <file> [seed]"
+                     << endl;
+                return 1;
+            }
+        }
+        return run_benchmarks(options);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,429 @@
+#include "contraction_hierarchy.h"
+#include "priority_queues.h"
+#include "atomic_file.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <iostream>
+
+static_assert(endian::native == endian::little, "contraction hierarchy files are little-endian");
+
+namespace {
+
+using Arc = ContractionHierarchy::Arc;
+
+constexpr char CH_MAGIC[8] = {'H', 'W', '9', 'C', 'H', '\0', '\0', '\0'};
+constexpr uint32_t CH_VERSION = 1;
+
+// A witness search gives up after settling this many vertices. Missing a witness only
+// costs an unneeded shortcut, never a wrong distance.
+constexpr int WITNESS_SETTLE_LIMIT = 500;
+
+struct CHHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numVertices;
+    uint64_t up_count;
+    uint64_t down_count;
+    uint64_t checksum;
+};
+
+// The part of the graph that has not been contracted yet, with shortcuts added so far.
+// Each vertex keeps at most one arc to any other vertex, the lightest one.
+class RemainingGraph {
+public:
+    explicit RemainingGraph(const CSRGraph& G)
+        : out(G.numVertices), in(G.numVertices), deleted_neighbors(G.numVertices, 0), distances(G.numVertices, INF),
+          target_of(G.numVertices, -1) {
+        for (int u = 0; u < G.numVertices; ++u) {
+            for (int i = G.offsets[u]; i < G.offsets[u + 1]; ++i) {
+                if (G.weight[i] < 0) {
+                    throw runtime_error("Contraction hierarchies need non-negative edge weights");
+                }
+                // Self-loops never lie on a shortest path
+                if (G.dst[i] != u) {
+                    add_arc(u, G.dst[i], G.weight[i], -1);
+                }
+            }
+        }
+    }
+
+    // Lower is contracted sooner: twice the shortcuts added minus arcs removed, plus
+    // the neighbors already contracted so the order spreads out over the graph
+    int priority(int v) {
+        return 2 * (contract(v, false) - int(in[v].size() + out[v].size())) + deleted_neighbors[v];
+    }
+
+    // Counts the shortcuts that contracting v needs and, when add is set, inserts them
+    int contract(int v, bool add) {
+        int needed = 0;
+        for (const Arc& second : out[v]) {
+            target_of[second.vertex] = v;
+        }
+        for (const Arc& first : in[v]) {
+            // A path through v too long for int is never a shortest one, so it needs no shortcut
+            int limit = -1, targets = 0, via;
+            for (const Arc& second : out[v]) {
+                if (second.vertex != first.vertex && add_path_length(first.weight, second.weight, via)) {
+                    limit = max(limit, via);
+                    ++targets;
+                }
+            }
+            if (targets == 0) continue;
+            witness_search(first.vertex, v, limit, targets);
+            for (const Arc& second : out[v]) {
+                if (second.vertex != first.vertex && add_path_length(first.weight, second.weight, via)
+                    && distances[second.vertex] > via) {
+                    ++needed;
+                    if (add) add_arc(first.vertex, second.vertex, via, v);
+                }
+            }
+        }
+        return needed;
+    }
+
+    // Detaches v from its neighbors and hands back its arcs
+    void remove(int v, vector<Arc>& up, vector<Arc>& down) {
+        for (const Arc& arc : in[v]) {
+            erase_arc(out[arc.vertex], v);
+            ++deleted_neighbors[arc.vertex];
+        }
+        for (const Arc& arc : out[v]) {
+            erase_arc(in[arc.vertex], v);
+            ++deleted_neighbors[arc.vertex];
+        }
+        up = move(out[v]);
+        down = move(in[v]);
+    }
+
+private:
+    void add_arc(int u, int w, int weight, int middle) {
+        auto existing = find_if(out[u].begin(), out[u].end(), [&](const Arc& arc) { return arc.vertex == w; });
+        if (existing == out[u].end()) {
+            out[u].push_back({w, weight, middle});
+            in[w].push_back({u, weight, middle});
+        } else if (weight < existing->weight) {
+            *existing = {w, weight, middle};
+            *find_if(in[w].begin(), in[w].end(), [&](const Arc& arc) { return arc.vertex == u; }) = {u, weight, middle};
+        }
+    }
+
+    static void erase_arc(vector<Arc>& arcs, int vertex) {
+        arcs.erase(find_if(arcs.begin(), arcs.end(), [&](const Arc& arc) { return arc.vertex == vertex; }));
+    }
+
+    // Dijkstra from source that avoids v, leaving distances up to limit in distances.
+    // It stops early once all `targets` vertices marked in target_of are settled.
+    void witness_search(int source, int v, int limit, int targets) {
+        for (int x : touched) distances[x] = INF;
+        touched.assign(1, source);
+        distances[source] = 0;
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> heap;
+        heap.push({0, source});
+        int settled = 0;
+        while (!heap.empty() && settled < WITNESS_SETTLE_LIMIT) {
+            auto [distance, x] = heap.top();
+            heap.pop();
+            if (distance > distances[x]) continue;
+            if (distance > limit) break;
+            if (x != source && target_of[x] == v && --targets == 0) break;
+            ++settled;
+            for (const Arc& arc : out[x]) {
+                int y = arc.vertex, length;
+                if (y == v || !add_path_length(distance, arc.weight, length) || length >= distances[y]) continue;
+                if (distances[y] == INF) touched.push_back(y);
+                distances[y] = length;
+                heap.push({distances[y], y});
+            }
+        }
+    }
+
+    vector<vector<Arc>> out;
+    vector<vector<Arc>> in;
+    vector<int> deleted_neighbors;
+    vector<int> distances;   // Witness search workspace, reset through touched
+    vector<int> touched;
+    vector<int> target_of;   // target_of[w] == v: w is an out-neighbor of the vertex v being contracted
+};
+
+void flatten(vector<vector<Arc>>& lists, vector<int>& offsets, vector<Arc>& arcs) {
+    offsets.assign(1, 0);
+    for (vector<Arc>& list : lists) {
+        arcs.insert(arcs.end(), list.begin(), list.end());
+        offsets.push_back(arcs.size());
+        vector<Arc>().swap(list);
+    }
+}
+
+// One direction of a hierarchy query. Sides are reused across queries on a thread, and
+// only the entries a query touched are reset, so a query costs O(settled) rather than O(n).
+struct QuerySide {
+    vector<int> distances;
+    vector<int> parents;    // Previous vertex on the way from this side's root
+    vector<int> middles;    // middle of the arc from parents[v] to v
+    vector<int> touched;
+    IndexedDaryHeap<4> heap{0};
+
+    void reset(int numVertices, int root) {
+        if (distances.size() != size_t(numVertices)) {
+            distances.assign(numVertices, INF);
+            parents.assign(numVertices, -1);
+            heap = IndexedDaryHeap<4>(numVertices);
+            middles.assign(numVertices, -1);
+        } else {
+            for (int v : touched) {
+                distances[v] = INF;
+                parents[v] = -1;
+                middles[v] = -1;
+            }
+            heap.clear();
+        }
+        touched.clear();
+        reach(root, 0, -1, -1);
+    }
+
+    void reach(int v, int distance, int parent, int middle) {
+        if (distances[v] == INF) touched.push_back(v);
+        distances[v] = distance;
+        parents[v] = parent;
+        middles[v] = middle;
+        heap.push(v, distance);
+    }
+};
+
+template <class T>
+void write_array(ofstream& out, const vector<T>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+}
+
+template <class T>
+bool read_array(ifstream& in, vector<T>& values, size_t count) {
+    values.resize(count);
+    return bool(in.read(reinterpret_cast<char*>(values.data()), sizeof(T) * count));
+}
+
+bool valid_offsets(const vector<int>& offsets, size_t count) {
+    if (offsets.front() != 0 || size_t(offsets.back()) != count) return false;
+    return is_sorted(offsets.begin(), offsets.end());
+}
+
+} // namespace
+
+ContractionHierarchy::ContractionHierarchy(const CSRGraph& G) {
+    int n = G.numVertices;
+    RemainingGraph graph(G);
+    vector<vector<Arc>> up(n), down(n);
+    ranks.assign(n, -1);
+
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> order;
+    for (int v = 0; v < n; ++v) {
+        order.push({graph.priority(v), v});
+    }
+    // Priorities go stale as neighbors are contracted, so each one is recomputed when it
+    // reaches the top and the vertex is put back if it is no longer the smallest
+    int next_rank = 0;
+    while (!order.empty()) {
+        int v = order.top().second;
+        order.pop();
+        if (ranks[v] != -1) continue;
+        int priority = graph.priority(v);
+        if (!order.empty() && priority > order.top().first) {
+            order.push({priority, v});
+            continue;
+        }
+        graph.contract(v, true);
+        graph.remove(v, up[v], down[v]);
+        ranks[v] = next_rank++;
+    }
+
+    flatten(up, up_offsets, up_arcs);
+    flatten(down, down_offsets, down_arcs);
+    for (const vector<Arc>* arcs : {&up_arcs, &down_arcs}) {
+        shortcuts += count_if(arcs->begin(), arcs->end(), [](const Arc& arc) { return arc.middle != -1; });
+    }
+}
+
+ShortestPath ContractionHierarchy::query(int source, int target) const {
+    int n = numVertices();
+    check_vertex(source, n);
+    check_vertex(target, n);
+
+    // Both searches only go upward, so neither can stop at the first meeting; each one
+    // runs until its smallest key reaches the best distance found
+    thread_local QuerySide forward, backward;
+    forward.reset(n, source);
+    backward.reset(n, target);
+    ShortestPath result;
+    int meeting = -1;
+    auto active = [&](const QuerySide& side) { return !side.heap.empty() && side.heap.min_key() < result.distance; };
+    while (active(forward) || active(backward)) {
+        bool ahead = active(forward) && (!active(backward) || forward.heap.min_key() <= backward.heap.min_key());
+        QuerySide& side = ahead ? forward : backward;
+        const QuerySide& other = ahead ? backward : forward;
+        const vector<int>& offsets = ahead ? up_offsets : down_offsets;
+        const vector<Arc>& arcs = ahead ? up_arcs : down_arcs;
+
+        int u = side.heap.pop();
+        ++result.settled;
+        int length;
+        if (other.distances[u] != INF && add_path_length(side.distances[u], other.distances[u], length)
+            && length < result.distance) {
+            result.distance = length;
+            meeting = u;
+        }
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+            const Arc& arc = arcs[i];
+            int distance;
+            if (add_path_length(side.distances[u], arc.weight, distance) && distance < side.distances[arc.vertex]) {
+                side.reach(arc.vertex, distance, u, arc.middle);
+            }
+        }
+    }
+    if (meeting == -1) {
+        return result;
+    }
+
+    vector<int> upward;
+    for (int v = meeting; v != -1; v = forward.parents[v]) {
+        upward.push_back(v);
+    }
+    result.path.push_back(source);
+    for (size_t i = upward.size() - 1; i > 0; --i) {
+        unpack(upward[i], upward[i - 1], forward.middles[upward[i - 1]], result.path);
+    }
+    for (int v = meeting; v != target; v = backward.parents[v]) {
+        unpack(v, backward.parents[v], backward.middles[v], result.path);
+    }
+    return result;
+}
+
+// Appends the original vertices after from on the arc from -> to
+void ContractionHierarchy::unpack(int from, int to, int middle, vector<int>& path) const {
+    vector<array<int, 3>> pending = {{from, to, middle}};
+    while (!pending.empty()) {
+        auto [a, b, m] = pending.back();
+        pending.pop_back();
+        if (m == -1) {
+            path.push_back(b);
+        } else {
+            pending.push_back({m, b, middle_of(m, b)});
+            pending.push_back({a, m, middle_of(a, m)});
+        }
+    }
+}
+
+// The arc between two vertices is stored with whichever was contracted first
+int ContractionHierarchy::middle_of(int from, int to) const {
+    if (ranks[from] < ranks[to]) {
+        for (int i = up_offsets[from]; i < up_offsets[from + 1]; ++i) {
+            if (up_arcs[i].vertex == to) return up_arcs[i].middle;
+        }
+    } else {
+        for (int i = down_offsets[to]; i < down_offsets[to + 1]; ++i) {
+            if (down_arcs[i].vertex == from) return down_arcs[i].middle;
+        }
+    }
+    throw runtime_error("Contraction hierarchy has no arc " + to_string(from) + " -> " + to_string(to));
+}
+
+void ContractionHierarchy::save(const string& file_name, const CSRGraph& G) const {
+    CHHeader header = {};
+    memcpy(header.magic, CH_MAGIC, sizeof(CH_MAGIC));
+    header.version = CH_VERSION;
+    header.numVertices = numVertices();
+    header.up_count = up_arcs.size();
+    header.down_count = down_arcs.size();
+    header.checksum = graph_checksum(G);
+
+    write_file_atomically(file_name, "contraction hierarchy", [&](ofstream& out) {
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        write_array(out, ranks);
+        write_array(out, up_offsets);
+        write_array(out, up_arcs);
+        write_array(out, down_offsets);
+        write_array(out, down_arcs);
+    });
+}
+
+shared_ptr<const ContractionHierarchy> ContractionHierarchy::open(const string& file_name, const CSRGraph& G) {
+    ifstream in(file_name, ios::binary);
+    CHHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || memcmp(header.magic, CH_MAGIC, sizeof(CH_MAGIC)) != 0 || header.version != CH_VERSION
+        || header.numVertices != uint32_t(G.numVertices) || header.checksum != graph_checksum(G)) {
+        return nullptr;
+    }
+    // The arc counts are checked against the file size before anything is allocated
+    uint64_t n = header.numVertices;
+    if (header.up_count > uint64_t(INF) || header.down_count > uint64_t(INF)) {
+        return nullptr;
+    }
+    in.seekg(0, ios::end);
+    uint64_t expected = sizeof(header) + sizeof(int) * (3 * n + 2) + sizeof(Arc) * (header.up_count + header.down_count);
+    if (uint64_t(in.tellg()) != expected) {
+        return nullptr;
+    }
+    in.seekg(sizeof(header));
+
+    shared_ptr<ContractionHierarchy> hierarchy(new ContractionHierarchy());
+    ContractionHierarchy& h = *hierarchy;
+    if (!read_array(in, h.ranks, n) || !read_array(in, h.up_offsets, n + 1) || !read_array(in, h.up_arcs, header.up_count)
+        || !read_array(in, h.down_offsets, n + 1) || !read_array(in, h.down_arcs, header.down_count)) {
+        return nullptr;
+    }
+
+    // A damaged file is rebuilt rather than trusted: ranks must be a permutation, arcs
+    // must point upward, and every shortcut must bypass a lower-ranked vertex
+    vector<bool> seen(n, false);
+    for (int rank : h.ranks) {
+        if (rank < 0 || uint64_t(rank) >= n || seen[rank]) return nullptr;
+        seen[rank] = true;
+    }
+    if (!valid_offsets(h.up_offsets, h.up_arcs.size()) || !valid_offsets(h.down_offsets, h.down_arcs.size())) {
+        return nullptr;
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+        const vector<int>& offsets = pass == 0 ? h.up_offsets : h.down_offsets;
+        const vector<Arc>& arcs = pass == 0 ? h.up_arcs : h.down_arcs;
+        for (uint64_t v = 0; v < n; ++v) {
+            for (int i = offsets[v]; i < offsets[v + 1]; ++i) {
+                const Arc& arc = arcs[i];
+                if (arc.vertex < 0 || uint64_t(arc.vertex) >= n || h.ranks[arc.vertex] <= h.ranks[v] || arc.weight < 0
+                    || arc.middle < -1 || (arc.middle != -1 && (uint64_t(arc.middle) >= n || h.ranks[arc.middle] >= h.ranks[v]))) {
+                    return nullptr;
+                }
+                if (arc.middle != -1) ++h.shortcuts;
+            }
+        }
+    }
+    return hierarchy;
+}
+
+uint64_t graph_checksum(const CSRGraph& G) {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](span<const int> values) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values.data());
+        for (size_t i = 0; i < values.size_bytes(); ++i) {
+            h = (h ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    mix(span(&G.numVertices, 1));
+    mix(G.offsets);
+    mix(G.dst);
+    mix(G.weight);
+    return h;
+}
+
+shared_ptr<const ContractionHierarchy> load_contraction_hierarchy(const CSRGraph& G, const string& cache_file) {
+    if (shared_ptr<const ContractionHierarchy> hierarchy = ContractionHierarchy::open(cache_file, G)) {
+        return hierarchy;
+    }
+    auto hierarchy = make_shared<const ContractionHierarchy>(G);
+    try {
+        hierarchy->save(cache_file, G);
+    } catch (const exception& e) {
+        cerr << "Warning: " << e.what() << endl;
+    }
+    return hierarchy;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dijkstras.h"
+
+using namespace std;
+
+// Contraction hierarchy over a graph with non-negative weights, for fast repeated
+// point-to-point queries. Preprocessing contracts the vertices one at a time in order of
+// importance (fewest added shortcuts first). Contracting v adds a shortcut u -> w for
+// each path u -> v -> w that has no shorter witness path around v, so distances among
+// the vertices left over never change. A query is then a bidirectional Dijkstra that
+// only climbs to higher-ranked vertices, and each shortcut is unpacked back into the
+// original edges through the vertex it bypasses.
+//
+// Distances always match dijkstra_shortest_path, except that a distance too long for
+// int, where Dijkstra throws, comes back as no path: the hierarchy no longer has the
+// graph to tell the two apart. Paths match extract_shortest_path when the shortest path
+// is unique; otherwise the path is another one of the same length.
+class ContractionHierarchy {
+public:
+    // An edge of the hierarchy. middle is the contracted vertex a shortcut bypasses,
+    // or -1 for an edge of the original graph.
+    struct Arc {
+        int vertex = 0;
+        int weight = 0;
+        int middle = -1;
+    };
+
+    ContractionHierarchy() = default;
+    explicit ContractionHierarchy(const CSRGraph& G);
+    explicit ContractionHierarchy(const Graph& G) : ContractionHierarchy(CSRGraph(G)) {}
+
+    int numVertices() const { return ranks.size(); }
+    int rank(int v) const { return ranks[v]; }
+    size_t arc_count() const { return up_arcs.size() + down_arcs.size(); }
+    size_t shortcut_count() const { return shortcuts; }
+
+    // Distance and unpacked path from source to target; settled counts the vertices
+    // finalized by both searches
+    ShortestPath query(int source, int target) const;
+
+    // Writes the hierarchy, tagged with a checksum of G, via a temporary file and a
+    // rename; throws runtime_error on failure
+    void save(const string& file_name, const CSRGraph& G) const;
+
+    // Reads a hierarchy file; returns nullptr if it is missing, malformed, or was built
+    // from a graph other than G
+    static shared_ptr<const ContractionHierarchy> open(const string& file_name, const CSRGraph& G);
+
+private:
+    void unpack(int from, int to, int middle, vector<int>& path) const;
+    int middle_of(int from, int to) const;
+
+    vector<int> ranks;           // Contraction order: lower ranks were contracted first
+    vector<int> up_offsets;      // up_arcs[up_offsets[v] ..): arcs v -> higher-ranked vertex
+    vector<Arc> up_arcs;
+    vector<int> down_offsets;    // down_arcs[down_offsets[v] ..): arcs higher-ranked vertex -> v
+    vector<Arc> down_arcs;
+    size_t shortcuts = 0;
+};
+
+// FNV-1a over the CSR arrays, used to tie a saved hierarchy to its graph
+uint64_t graph_checksum(const CSRGraph& G);
+
+// Returns the hierarchy saved in cache_file when it was built from G; otherwise builds
+// one, writes it to cache_file (warning on cerr if that fails) and returns it
+shared_ptr<const ContractionHierarchy> load_contraction_hierarchy(const CSRGraph& G, const string& cache_file);
@@ -0,0 +1,222 @@
+#include "delta_stepping.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace {
+
+// A vertex's tentative distance and parent in one word, so both change in one CAS
+uint64_t pack(int distance, int parent) {
+    return uint64_t(uint32_t(distance)) << 32 | uint32_t(parent);
+}
+
+int distance_of(uint64_t packed) { return int(packed >> 32); }
+int parent_of(uint64_t packed) { return int(uint32_t(packed)); }
+
+// The graph with each vertex's light edges moved in front of its heavy ones
+struct SplitGraph {
+    vector<int> offsets;
+    vector<int> light_end;   // Light edges of u are offsets[u] .. light_end[u] - 1
+    vector<int> dst;
+    vector<int> weight;
+
+    SplitGraph(const CSRGraph& G, int delta)
+        : offsets(G.offsets.begin(), G.offsets.end()), light_end(G.numVertices), dst(G.numEdges()), weight(G.numEdges()) {
+        for (int u = 0; u < G.numVertices; ++u) {
+            int light = offsets[u], heavy = offsets[u + 1];
+            for (int i = G.offsets[u]; i < G.offsets[u + 1]; ++i) {
+                int slot = G.weight[i] <= delta ? light++ : --heavy;
+                dst[slot] = G.dst[i];
+                weight[slot] = G.weight[i];
+            }
+            light_end[u] = light;
+        }
+    }
+};
+
+// Most buckets the ring holds; entries further ahead wait in an overflow heap, so one
+// huge weight with a narrow delta can't blow up the allocation
+constexpr long MAX_RING_BUCKETS = 4096;
+
+class DeltaStepping {
+public:
+    DeltaStepping(const CSRGraph& G, int delta, unsigned threads)
+        : graph(G, delta), delta(delta), tentative(G.numVertices), last_pass(G.numVertices, -1),
+          in_settled(G.numVertices, -1), improved(threads), overflowed(threads) {
+        int maxWeight = 0;
+        for (int w : G.weight) maxWeight = max(maxWeight, w);
+        // Pending distances span at most maxWeight past the current bucket, so for
+        // ordinary weights the ring alone covers them
+        buckets.resize(min(long(maxWeight) / delta + 2, MAX_RING_BUCKETS));
+        if (threads > 1) pool = make_unique<ThreadPool>(threads);
+        for (auto& entry : tentative) entry.store(pack(INF, -1), memory_order_relaxed);
+    }
+
+    void run(int source, vector<int>& distances, vector<int>& previous) {
+        tentative[source].store(pack(0, -1), memory_order_relaxed);
+        add(source);
+        int pass = 0;
+        for (current = 0; pending > 0 || !overflow.empty(); ++current) {
+            if (pending == 0) {
+                // Nothing in the ring: jump straight to the nearest overflow bucket
+                current = overflow.front().first;
+            }
+            long ring_end = current + long(buckets.size());
+            while (!overflow.empty() && overflow.front().first < ring_end) {
+                pop_heap(overflow.begin(), overflow.end(), greater<>());
+                auto [index, v] = overflow.back();
+                overflow.pop_back();
+                buckets[index % buckets.size()].push_back(v);
+                ++pending;
+            }
+            vector<int>& bucket = buckets[current % buckets.size()];
+            settled.clear();
+            // Light edges can put vertices back into this bucket, so it is drained until empty
+            while (!bucket.empty()) {
+                frontier.clear();
+                frontier.swap(bucket);
+                pending -= frontier.size();
+                ++pass;
+                // Skip entries whose vertex has since moved to a lower bucket or is already here
+                erase_if(frontier, [&](int v) {
+                    if (distance(v) / delta != current || last_pass[v] == pass) return true;
+                    last_pass[v] = pass;
+                    return false;
+                });
+                for (int v : frontier) {
+                    if (in_settled[v] != current) {
+                        in_settled[v] = current;
+                        settled.push_back(v);
+                    }
+                }
+                relax(frontier, true);
+            }
+            relax(settled, false);
+        }
+
+        int n = tentative.size();
+        distances.resize(n);
+        previous.resize(n);
+        for (int v = 0; v < n; ++v) {
+            uint64_t packed = tentative[v].load(memory_order_relaxed);
+            distances[v] = distance_of(packed);
+            previous[v] = parent_of(packed);
+        }
+        // As in dijkstra_shortest_path, a head left unreached behind an overflowing edge
+        // has a distance int can't hold
+        for (const vector<int>& skipped : overflowed) {
+            for (int v : skipped) {
+                if (distances[v] == INF) {
+                    throw runtime_error("Distance to vertex " + to_string(v) + " overflows the 32-bit edge weight type");
+                }
+            }
+        }
+    }
+
+private:
+    int distance(int v) const { return distance_of(tentative[v].load(memory_order_relaxed)); }
+
+    void add(int v) {
+        long index = distance(v) / delta;
+        if (index >= current + long(buckets.size())) {
+            overflow.push_back({index, v});
+            push_heap(overflow.begin(), overflow.end(), greater<>());
+            return;
+        }
+        buckets[index % buckets.size()].push_back(v);
+        ++pending;
+    }
+
+    // Relaxes the light or heavy edges of vertices, split over the threads, then files
+    // every vertex whose distance went down into its bucket
+    void relax(const vector<int>& vertices, bool light) {
+        unsigned chunks = improved.size();
+        auto work = [&](unsigned chunk) {
+            vector<int>& out = improved[chunk];
+            vector<int>& skipped = overflowed[chunk];
+            size_t begin = vertices.size() * chunk / chunks, end = vertices.size() * (chunk + 1) / chunks;
+            for (size_t k = begin; k < end; ++k) {
+                int u = vertices[k];
+                int base = distance(u);
+                int first = light ? graph.offsets[u] : graph.light_end[u];
+                int last = light ? graph.light_end[u] : graph.offsets[u + 1];
+                for (int i = first; i < last; ++i) {
+                    int distance;
+                    if (!add_path_length(base, graph.weight[i], distance)) {
+                        skipped.push_back(graph.dst[i]);
+                    } else if (lower(graph.dst[i], distance, u)) {
+                        out.push_back(graph.dst[i]);
+                    }
+                }
+            }
+        };
+        if (!pool || vertices.size() < 2 * chunks) {
+            for (unsigned chunk = 0; chunk < chunks; ++chunk) work(chunk);
+        } else {
+            vector<future<void>> done;
+            for (unsigned chunk = 0; chunk < chunks; ++chunk) {
+                done.push_back(pool->submit([&work, chunk] { work(chunk); }));
+            }
+            for (future<void>& chunk_done : done) chunk_done.get();
+        }
+        for (vector<int>& out : improved) {
+            for (int v : out) add(v);
+            out.clear();
+        }
+    }
+
+    // Sets v's distance and parent together if distance is lower. Ties never move the
+    // parent, so parents always got their final distance before their children and
+    // zero-weight cycles can't turn into cycles in previous.
+    bool lower(int v, int distance, int parent) {
+        uint64_t seen = tentative[v].load(memory_order_relaxed);
+        while (distance < distance_of(seen)) {
+            if (tentative[v].compare_exchange_weak(seen, pack(distance, parent), memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SplitGraph graph;
+    int delta;
+    vector<atomic<uint64_t>> tentative;
+    vector<int> last_pass;    // Pass that last took v from a bucket, to drop duplicates
+    vector<long> in_settled;  // Bucket whose settled list holds v
+    vector<vector<int>> buckets;       // Ring of the buckets from current on
+    vector<pair<long, int>> overflow;  // Min-heap of (bucket, vertex) past the ring
+    long current = 0;
+    vector<int> frontier;
+    vector<int> settled;
+    vector<vector<int>> improved;  // Per-chunk lists of vertices whose distance went down
+    vector<vector<int>> overflowed;  // Per-chunk heads of relaxations too long for int
+    size_t pending = 0;            // Entries in the ring
+    unique_ptr<ThreadPool> pool;
+};
+
+} // namespace
+
+int tune_delta(const CSRGraph& G) {
+    if (G.numEdges() == 0) return 1;
+    long long total = 0;
+    for (int w : G.weight) total += w;
+    double average_weight = double(total) / G.numEdges();
+    double average_degree = double(G.numEdges()) / G.numVertices;
+    return max(1, int(average_weight / max(1.0, average_degree) + 0.5));
+}
+
+vector<int> delta_stepping_shortest_path(const CSRGraph& G, int source, vector<int>& previous,
+                                         const DeltaSteppingOptions& options) {
+    check_vertex(source, G.numVertices);
+    if (any_of(G.weight.begin(), G.weight.end(), [](int w) { return w < 0; })) {
+        throw runtime_error("Delta stepping needs non-negative edge weights");
+    }
+    int delta = options.delta > 0 ? options.delta : tune_delta(G);
+    unsigned threads = options.threads > 0 ? options.threads : max(1u, thread::hardware_concurrency());
+
+    vector<int> distances;
+    DeltaStepping(G, delta, threads).run(source, distances, previous);
+    return distances;
+}
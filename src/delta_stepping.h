@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include "dijkstras.h"
+
+using namespace std;
+
+struct DeltaSteppingOptions {
+    int delta = 0;          // Bucket width; 0 picks one with tune_delta
+    unsigned threads = 0;   // 0 means one per hardware thread
+};
+
+// Bucket width for delta stepping: the average edge weight divided by the average out
+// degree, so a bucket holds about one edge's worth of distance per neighbor. Wider
+// buckets mean fewer, larger parallel phases but more re-relaxed vertices.
+int tune_delta(const CSRGraph& G);
+
+// Parallel single-source shortest paths by delta stepping. Distances are kept in
+// buckets of width delta. Edges of weight <= delta are "light" and relaxed repeatedly
+// while the current bucket refills; the "heavy" ones are relaxed once per bucket.
+// Each phase splits its vertices over the threads, which lower the packed
+// (distance, parent) of each neighbor with a compare-and-swap.
+//
+// Returns the same distances as dijkstra_shortest_path. previous is a valid
+// shortest-path tree, but where paths tie the parent depends on which relaxation
+// landed first, so it can differ from Dijkstra's. Needs non-negative weights.
+vector<int> delta_stepping_shortest_path(const CSRGraph& G, int source, vector<int>& previous,
+                                         const DeltaSteppingOptions& options = {});
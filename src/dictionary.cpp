@@ -0,0 +1,178 @@
+#include "dictionary.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static uint64_t fnv1a(string_view bytes, uint64_t h = 14695981039346656037ull) {
+    for (char c : bytes) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static size_t hash_word(string_view word) {
+    return fnv1a(word);
+}
+
+Dictionary::Dictionary(const set<string>& word_list) {
+    build(vector<string_view>(word_list.begin(), word_list.end()));
+}
+
+Dictionary::Dictionary(const vector<string_view>& words) {
+    build(words);
+}
+
+Dictionary Dictionary::from_lowercase(vector<string_view> words) {
+    Dictionary dictionary;
+    dictionary.intern(move(words));
+    return dictionary;
+}
+
+void Dictionary::build(vector<string_view> words) {
+    // Lowercase everything into a scratch arena first, since lowercasing can reorder
+    // words and merge duplicates
+    size_t total = 0;
+    for (string_view word : words) total += word.size();
+    string scratch;
+    scratch.reserve(total);
+    for (string_view& word : words) {
+        size_t start = scratch.size();
+        for (char c : word) scratch.push_back(tolower(c));
+        word = string_view(scratch).substr(start, word.size());
+    }
+    intern(move(words));
+}
+
+void Dictionary::intern(vector<string_view> words) {
+    // Word lists are usually already sorted, which makes this close to a linear pass
+    if (!is_sorted(words.begin(), words.end())) {
+        sort(words.begin(), words.end());
+    }
+    words.erase(unique(words.begin(), words.end()), words.end());
+
+    size_t total = 0;
+    for (string_view word : words) total += word.size();
+    arena.clear();
+    arena.reserve(total);
+    offsets.assign(1, 0);
+    offsets.reserve(words.size() + 1);
+    size_t max_len = 0;
+    for (string_view word : words) {
+        arena.append(word);
+        offsets.push_back(arena.size());
+        max_len = max(max_len, word.size());
+    }
+
+    // Open addressing with linear probing, kept at most half full
+    size_t capacity = 16;
+    while (capacity < 2 * words.size()) capacity *= 2;
+    slots.assign(capacity, -1);
+    for (int id = 0; id < size(); id++) {
+        size_t slot = hash_word(word(id)) & (capacity - 1);
+        while (slots[slot] != -1) slot = (slot + 1) & (capacity - 1);
+        slots[slot] = id;
+    }
+
+    // Counting sort of ids by length; ids stay in order within each length
+    length_starts.assign(max_len + 2, 0);
+    for (int id = 0; id < size(); id++) length_starts[word(id).size() + 1]++;
+    for (size_t len = 1; len < length_starts.size(); len++) length_starts[len] += length_starts[len - 1];
+    by_length.resize(size());
+    vector<int> next(length_starts.begin(), length_starts.end() - 1);
+    for (int id = 0; id < size(); id++) by_length[next[word(id).size()]++] = id;
+}
+
+int Dictionary::find(string_view word) const {
+    if (slots.empty()) return -1;
+    size_t mask = slots.size() - 1;
+    for (size_t slot = hash_word(word) & mask; slots[slot] != -1; slot = (slot + 1) & mask) {
+        if (this->word(slots[slot]) == word) return slots[slot];
+    }
+    return -1;
+}
+
+uint64_t Dictionary::checksum() const {
+    uint64_t h = fnv1a(arena);
+    for (unsigned offset : offsets) {
+        h = fnv1a(string_view(reinterpret_cast<const char*>(&offset), sizeof(offset)), h);
+    }
+    return h;
+}
+
+span<const int> Dictionary::words_of_length(int len) const {
+    if (len < 0 || len > max_length()) return {};
+    return span<const int>(by_length).subspan(length_starts[len], length_starts[len + 1] - length_starts[len]);
+}
+
+void load_words(Dictionary& dictionary, const string& file_name) {
+    ifstream file(file_name);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file " << file_name << endl;
+        dictionary = Dictionary();
+        return;
+    }
+
+    string contents((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    vector<string_view> words;
+    size_t i = 0;
+    while (i < contents.size()) {
+        while (i < contents.size() && isspace(static_cast<unsigned char>(contents[i]))) i++;
+        size_t start = i;
+        while (i < contents.size() && !isspace(static_cast<unsigned char>(contents[i]))) i++;
+        if (i > start) words.emplace_back(contents.data() + start, i - start);
+    }
+    dictionary = Dictionary(words);
+}
+
+static bool is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+void load_words_mapped(Dictionary& dictionary, const string& file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd == -1) {
+        cerr << "Error: Could not open file " << file_name << endl;
+        dictionary = Dictionary();
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1 || info.st_size == 0) {
+        close(fd);
+        dictionary = Dictionary();
+        return;
+    }
+
+    // A private writable mapping lets us lowercase in place without touching the file
+    size_t size = info.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        cerr << "Error: Could not map file " << file_name << endl;
+        dictionary = Dictionary();
+        return;
+    }
+    char* data = static_cast<char*>(mapping);
+
+    // Branch-free ASCII lowercasing over the whole buffer, which the compiler vectorizes
+    for (size_t i = 0; i < size; i++) {
+        unsigned char c = data[i];
+        data[i] = c + (static_cast<unsigned char>(c - 'A') < 26 ? 32 : 0);
+    }
+
+    vector<string_view> words;
+    words.reserve(size / 8);
+    const char* end = data + size;
+    for (const char* p = data; p < end;) {
+        while (p < end && is_space(*p)) p++;
+        const char* start = p;
+        while (p < end && !is_space(*p)) p++;
+        if (p > start) words.emplace_back(start, p - start);
+    }
+    dictionary = Dictionary::from_lowercase(move(words));
+    munmap(mapping, size);
+}
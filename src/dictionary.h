@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Interned word list: every word lives once in a single contiguous arena and is
+// known by a dense id. Ids follow sorted order, the same order a set<string>
+// iterates in. Lookups go through an open-addressing hash table, and the ids of
+// each word length are stored contiguously so they can be handed out as spans.
+class Dictionary {
+public:
+    Dictionary() = default;
+    explicit Dictionary(const set<string>& word_list);
+
+    // Words are lowercased, sorted and deduplicated
+    explicit Dictionary(const vector<string_view>& words);
+
+    // Same, for words that are already lowercase; they are copied only once, into the arena
+    static Dictionary from_lowercase(vector<string_view> words);
+
+    int size() const { return static_cast<int>(offsets.size()) - 1; }
+    bool empty() const { return size() == 0; }
+    int max_length() const { return static_cast<int>(length_starts.size()) - 2; }
+
+    string_view word(int id) const {
+        return string_view(arena.data() + offsets[id], offsets[id + 1] - offsets[id]);
+    }
+
+    // Returns the id of a lowercase word, or -1 if it is not in the dictionary
+    int find(string_view word) const;
+    bool contains(string_view word) const { return find(word) != -1; }
+
+    // Ids of all words of the given length, in id order
+    span<const int> words_of_length(int len) const;
+
+    // Fingerprint of the word list (FNV-1a over the words and their boundaries)
+    uint64_t checksum() const;
+
+    // Raw arena and per-word start offsets (size() + 1 entries), for serialization
+    const string& characters() const { return arena; }
+    const vector<unsigned>& word_offsets() const { return offsets; }
+
+private:
+    void build(vector<string_view> words);
+    void intern(vector<string_view> words);
+
+    string arena;
+    vector<unsigned> offsets = {0};
+    vector<int> slots;             // Hash table of ids, -1 marks an empty slot
+    vector<int> by_length;         // Ids grouped by word length
+    vector<int> length_starts = {0, 0};
+};
+
+// Both loaders report an unreadable file on cerr and leave the dictionary empty
+void load_words(Dictionary& dictionary, const string& file_name);
+
+// Faster cold-start loader: memory-maps the file, lowercases it in place and builds
+// the dictionary from views into the mapping
+void load_words_mapped(Dictionary& dictionary, const string& file_name);
@@ -1,43 +1,750 @@
 #include "dijkstras.h"
+#include "priority_queues.h"
+#include "atomic_file.h"
+#include "thread_pool.h"
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous) {
+static_assert(endian::native == endian::little, "binary graph files are little-endian");
+
+template <EdgeWeight Weight>
+BasicCSRGraph<Weight>::BasicCSRGraph(const BasicGraph<Weight>& G) {
+    vector<int> offsets(G.numVertices + 1, 0), dst;
+    vector<Weight> weight;
+    for (int u = 0; u < G.numVertices; ++u) {
+        offsets[u + 1] = offsets[u] + G[u].size();
+    }
+    dst.reserve(offsets[G.numVertices]);
+    weight.reserve(offsets[G.numVertices]);
+    for (int u = 0; u < G.numVertices; ++u) {
+        for (const BasicEdge<Weight>& edge : G[u]) {
+            dst.push_back(edge.dst);
+            weight.push_back(edge.weight);
+        }
+    }
+    *this = BasicCSRGraph(move(offsets), move(dst), move(weight));
+}
+
+template <EdgeWeight Weight>
+BasicCSRGraph<Weight>::BasicCSRGraph(int n, const vector<BasicEdge<Weight>>& edges) {
+    vector<int> offsets(n + 1, 0), dst(edges.size());
+    vector<Weight> weight(edges.size());
+    // Counting sort by source keeps each vertex's edges in input order
+    for (const BasicEdge<Weight>& edge : edges) {
+        check_edge(edge, n);
+        ++offsets[edge.src + 1];
+    }
+    for (int u = 0; u < n; ++u) {
+        offsets[u + 1] += offsets[u];
+    }
+    vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (const BasicEdge<Weight>& edge : edges) {
+        int slot = next[edge.src]++;
+        dst[slot] = edge.dst;
+        weight[slot] = edge.weight;
+    }
+    *this = BasicCSRGraph(move(offsets), move(dst), move(weight));
+}
+
+template <EdgeWeight Weight>
+BasicCSRGraph<Weight>::BasicCSRGraph(vector<int> offsets_, vector<int> dst_, vector<Weight> weight_) {
+    if (offsets_.empty() || offsets_.front() != 0 || size_t(offsets_.back()) != dst_.size()
+        || dst_.size() != weight_.size()) {
+        throw runtime_error("CSR arrays don't match: " + to_string(offsets_.size()) + " offsets, "
+                            + to_string(dst_.size()) + " destinations, " + to_string(weight_.size()) + " weights");
+    }
+    struct Arrays {
+        vector<int> offsets, dst;
+        vector<Weight> weight;
+    };
+    auto arrays = make_shared<const Arrays>(Arrays{move(offsets_), move(dst_), move(weight_)});
+    numVertices = arrays->offsets.size() - 1;
+    offsets = arrays->offsets;
+    dst = arrays->dst;
+    weight = arrays->weight;
+    storage = move(arrays);
+}
+
+namespace {
+
+bool is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Reads the vertex count and every edge of a text graph into one pre-sized edge list
+template <EdgeWeight Weight>
+vector<BasicEdge<Weight>> parse_edges(string_view text, int& numVertices) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+
+    size_t tokens = 0;
+    for (const char* p = begin; p < end; ++p) {
+        tokens += !is_space(*p) && (p == begin || is_space(p[-1]));
+    }
+
+    const char* p = begin;
+    auto fail = [&](const string& msg) {
+        throw runtime_error(msg + " on line " + to_string(1 + count(begin, p, '\n')) + " of graph file");
+    };
+    auto next_number = [&](auto& value) {
+        while (p < end && is_space(*p)) ++p;
+        if (p == end) return false;
+        auto [stop, ec] = from_chars(p, end, value);
+        if (ec != errc() || (stop < end && !is_space(*stop))) fail("Invalid number");
+        p = stop;
+        return true;
+    };
+
+    if (!next_number(numVertices))
+        throw runtime_error("Unable to find input file");
+    if (numVertices < 0) fail("Negative vertex count");
+
+    vector<BasicEdge<Weight>> edges;
+    edges.reserve((tokens - 1) / 3);
+    for (BasicEdge<Weight> e; next_number(e.src);) {
+        if (!next_number(e.dst) || !next_number(e.weight)) fail("Incomplete edge");
+        check_edge(e, numVertices);
+        edges.push_back(e);
+    }
+    return edges;
+}
+
+// Read-only view of a whole file, memory-mapped for the lifetime of the object
+class MappedFile {
+public:
+    explicit MappedFile(const string& filename) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw runtime_error("Can't open input file");
+        }
+        struct stat info;
+        if (fstat(fd, &info) == -1) {
+            close(fd);
+            throw runtime_error("Can't open input file");
+        }
+        size = info.st_size;
+        if (size > 0) {
+            data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw runtime_error("Can't map input file");
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+        if (size > 0) munmap(data, size);
+    }
+
+    string_view text() const { return size > 0 ? string_view(static_cast<const char*>(data), size) : string_view(); }
+
+private:
+    void* data = nullptr;
+    size_t size = 0;
+};
+
+constexpr char BINARY_GRAPH_MAGIC[8] = {'H', 'W', '9', 'G', 'R', 'A', 'P', 'H'};
+constexpr uint32_t BINARY_GRAPH_VERSION = 1;
+
+struct BinaryGraphHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t numVertices;
+    uint64_t numEdges;
+};
+
+// Byte offsets of the arrays in a binary graph file
+struct BinaryGraphLayout {
+    uint64_t offsets, dst, weight, size;
+
+    explicit BinaryGraphLayout(const BinaryGraphHeader& header) {
+        auto align = [](uint64_t bytes) { return (bytes + BINARY_GRAPH_ALIGNMENT - 1) / BINARY_GRAPH_ALIGNMENT * BINARY_GRAPH_ALIGNMENT; };
+        offsets = align(sizeof(BinaryGraphHeader));
+        dst = align(offsets + sizeof(int) * (header.numVertices + 1));
+        weight = align(dst + sizeof(int) * header.numEdges);
+        size = weight + sizeof(int) * header.numEdges;
+    }
+};
+
+bool is_binary_graph(string_view file) {
+    return file.size() >= sizeof(BINARY_GRAPH_MAGIC) && memcmp(file.data(), BINARY_GRAPH_MAGIC, sizeof(BINARY_GRAPH_MAGIC)) == 0;
+}
+
+// CSR views straight into a mapped binary graph file; the caller keeps the mapping alive
+CSRGraph view_binary_graph(string_view file, const string& filename) {
+    auto fail = [&](const string& msg) { throw runtime_error("Binary graph " + filename + ": " + msg); };
+    BinaryGraphHeader header;
+    if (file.size() < sizeof(header)) fail("truncated header");
+    memcpy(&header, file.data(), sizeof(header));
+    if (header.version != BINARY_GRAPH_VERSION) fail("unsupported version " + to_string(header.version));
+    if (header.header_size != sizeof(header)) fail("unexpected header size");
+    if (header.numVertices >= uint64_t(INF) || header.numEdges > uint64_t(INF)) fail("too many vertices or edges");
+    BinaryGraphLayout layout(header);
+    if (file.size() != layout.size) fail("file is " + to_string(file.size()) + " bytes, expected " + to_string(layout.size));
+
+    CSRGraph G;
+    G.numVertices = header.numVertices;
+    G.offsets = span(reinterpret_cast<const int*>(file.data() + layout.offsets), header.numVertices + 1);
+    G.dst = span(reinterpret_cast<const int*>(file.data() + layout.dst), header.numEdges);
+    G.weight = span(reinterpret_cast<const int*>(file.data() + layout.weight), header.numEdges);
+    if (G.offsets.front() != 0 || uint64_t(G.offsets.back()) != header.numEdges) fail("offsets don't cover the edges");
+    // One pass over both arrays, so a damaged file can't send a search out of bounds
+    for (int u = 0; u < G.numVertices; ++u) {
+        if (G.offsets[u] > G.offsets[u + 1]) fail("offsets decrease at vertex " + to_string(u));
+    }
+    for (int e = 0; e < G.numEdges(); ++e) {
+        if (G.dst[e] < 0 || G.dst[e] >= G.numVertices) fail("edge " + to_string(e) + " leads to vertex " + to_string(G.dst[e]));
+    }
+    return G;
+}
+
+template <EdgeWeight Weight, class F>
+void for_each_edge(const BasicGraph<Weight>& G, int u, F visit) {
+    for (const BasicEdge<Weight>& edge : G[u]) {
+        visit(edge.dst, edge.weight);
+    }
+}
+
+template <EdgeWeight Weight, class F>
+void for_each_edge(const BasicCSRGraph<Weight>& G, int u, F visit) {
+    for (int e = G.offsets[u]; e < G.offsets[u + 1]; ++e) {
+        visit(G.dst[e], G.weight[e]);
+    }
+}
+
+// Smallest and largest edge weight, or (0, 0) for a graph without edges
+template <class GraphType>
+auto weight_range(const GraphType& G) {
+    using Weight = typename GraphType::weight_type;
+    Weight lo = INF_WEIGHT<Weight>, hi = 0;
+    for (int u = 0; u < G.numVertices; ++u) {
+        for_each_edge(G, u, [&](int, Weight weight) {
+            lo = min(lo, weight);
+            hi = max(hi, weight);
+        });
+    }
+    return pair<Weight, Weight>{lo == INF_WEIGHT<Weight> ? 0 : lo, hi};
+}
+
+// Settles vertices in distance order until the queue runs dry or target (if not -1) is
+// settled; *stats, when given, counts the work. The arrays are resized in place, so
+// callers that keep them between runs don't allocate.
+template <class GraphType, class Queue>
+void run_dijkstra(const GraphType& G, int source, vector<typename GraphType::weight_type>& distances,
+                  vector<int>& previous, vector<bool>& visited, Queue& minHeap, int target = -1,
+                  DijkstraStats* stats = nullptr) {
+    using Weight = typename GraphType::weight_type;
+    constexpr Weight UNREACHED = INF_WEIGHT<Weight>;
     int numVertices = G.numVertices;
     
-    vector<int> distances(numVertices, INF);
-    vector<bool> visited(numVertices, false);
+    distances.assign(numVertices, UNREACHED);
+    visited.assign(numVertices, false);
     previous.assign(numVertices, -1);
     
+    // Counters that compile away without instrumentation
+    auto count = [stats](size_t DijkstraStats::*counter) {
+        if constexpr (STATS_ENABLED) {
+            if (stats) ++(stats->*counter);
+        }
+    };
+
+    // Heads of edges whose path length didn't fit; empty unless weights are that large
+    vector<int> overflowed;
+
     distances[source] = 0;
-    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> minHeap;
-    minHeap.push({0, source});
+    minHeap.push(source, 0);
+    count(&DijkstraStats::heap_pushes);
     
     while (!minHeap.empty()) {
-        int u = minHeap.top().second;
-        minHeap.pop();
+        int u = minHeap.pop();
         if (visited[u]) {
+            count(&DijkstraStats::stale_pops);
             continue;
         }
         visited[u] = true;
-        for (const Edge& edge : G[u]) {
-            int v = edge.dst;
-            int weight = edge.weight;
-            
-            if (!visited[v] && distances[u] != INF && distances[u] + weight < distances[v]) {
-                distances[v] = distances[u] + weight;
+        if (stats) {
+            ++stats->settled;
+        }
+        if (u == target) {
+            break;
+        }
+        for_each_edge(G, u, [&](int v, Weight weight) {
+            count(&DijkstraStats::relaxations);
+            if (visited[v] || distances[u] == UNREACHED) {
+                return;
+            }
+            Weight distance;
+            if (!add_path_length(distances[u], weight, distance)) {
+                overflowed.push_back(v);
+                return;
+            }
+            if (distance < distances[v]) {
+                distances[v] = distance;
                 previous[v] = u;
-                minHeap.push({distances[v], v});
+                minHeap.push(v, distance);
+                count(&DijkstraStats::heap_pushes);
             }
-        }
+        });
     }
-    
+
+    // Once the search has run dry, a head still unreached only had edges in whose sums
+    // overflowed, so its distance is finite but has no representation in Weight
+    if (target != -1 && visited[target]) {
+        return;
+    }
+    auto fail = [](int v) {
+        throw runtime_error("Distance to vertex " + to_string(v) + " overflows the " + to_string(sizeof(Weight) * 8)
+                            + "-bit edge weight type; use a wider one");
+    };
+    erase_if(overflowed, [&](int v) { return distances[v] != UNREACHED; });
+    if (target == -1) {
+        if (!overflowed.empty()) fail(overflowed.front());
+        return;
+    }
+    // For one target only that target counts: every path to it from the settled
+    // vertices leaves them through an overflowing edge, so it is reachable exactly when
+    // it is reachable from one of those heads
+    vector<bool> seen(numVertices, false);
+    for (int v : overflowed) seen[v] = true;
+    while (!overflowed.empty()) {
+        int u = overflowed.back();
+        overflowed.pop_back();
+        if (u == target) fail(target);
+        for_each_edge(G, u, [&](int v, Weight) {
+            if (!seen[v]) {
+                seen[v] = true;
+                overflowed.push_back(v);
+            }
+        });
+    }
+}
+
+template <class GraphType, class Queue>
+auto dijkstra(const GraphType& G, int source, vector<int>& previous, Queue&& minHeap,
+              int target = -1, DijkstraStats* stats = nullptr) {
+    vector<typename GraphType::weight_type> distances;
+    vector<bool> visited;
+    run_dijkstra(G, source, distances, previous, visited, minHeap, target, stats);
     return distances;
 }
 
-vector<int> extract_shortest_path(const vector<int>& distances, const vector<int>& previous, int destination) {
+template <class GraphType>
+vector<typename GraphType::weight_type> dijkstra(const GraphType& G, int source, vector<int>& previous,
+                                                 DijkstraQueue queue, int target = -1,
+                                                 DijkstraStats* stats = nullptr) {
+    using Weight = typename GraphType::weight_type;
+    int n = G.numVertices;
+    check_vertex(source, n);
+    if constexpr (!is_same_v<Weight, int>) {
+        // The radix heap and bucket queue index by int keys
+        if (queue == DijkstraQueue::Radix || queue == DijkstraQueue::Dial) {
+            throw runtime_error("Radix heap and Dial's buckets need int edge weights");
+        }
+        if (queue == DijkstraQueue::IndexedDary) {
+            return dijkstra(G, source, previous, IndexedDaryHeap<4, Weight>(n), target, stats);
+        }
+        return dijkstra(G, source, previous, LazyBinaryHeap<Weight>(n), target, stats);
+    } else {
+        if (queue == DijkstraQueue::LazyBinary) {
+            return dijkstra(G, source, previous, LazyBinaryHeap(n), target, stats);
+        }
+        if (queue == DijkstraQueue::IndexedDary) {
+            return dijkstra(G, source, previous, IndexedDaryHeap<4>(n), target, stats);
+        }
+
+        auto [lo, hi] = weight_range(G);
+        if (queue == DijkstraQueue::Auto) {
+            queue = lo < 0 ? DijkstraQueue::LazyBinary : hi <= DIAL_MAX_WEIGHT ? DijkstraQueue::Dial : DijkstraQueue::Radix;
+            return dijkstra(G, source, previous, queue, target, stats);
+        }
+        if (lo < 0) {
+            throw runtime_error("Radix heap and Dial's buckets need non-negative edge weights");
+        }
+        if (queue == DijkstraQueue::Dial) {
+            return dijkstra(G, source, previous, DialBucketQueue(n, hi), target, stats);
+        }
+        return dijkstra(G, source, previous, RadixHeap(n), target, stats);
+    }
+}
+
+template <class GraphType>
+ShortestPath point_to_point(const GraphType& G, int source, int target, DijkstraQueue queue,
+                            DijkstraStats& stats) {
+    check_vertex(source, G.numVertices);
+    check_vertex(target, G.numVertices);
+    ShortestPath result;
+    vector<int> previous;
+    stats = {};
+    vector<int> distances = dijkstra(G, source, previous, queue, target, &stats);
+    result.settled = stats.settled;
+    result.distance = distances[target];
+    result.path = extract_shortest_path(distances, previous, target);
+    return result;
+}
+
+// Text output gathered in memory and handed to the stream a block at a time
+class OutputBuffer {
+public:
+    explicit OutputBuffer(ostream& out) : out(out) { buffer.reserve(BLOCK + 256); }
+
+    void append(string_view text) {
+        buffer += text;
+        if (buffer.size() >= BLOCK) flush();
+    }
+
+    void append(int value) {
+        char digits[16];
+        auto [end, ec] = to_chars(digits, digits + sizeof digits, value);
+        append(string_view(digits, end - digits));
+    }
+
+    void flush() {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+private:
+    static constexpr size_t BLOCK = 1 << 20;
+    ostream& out;
+    string buffer;
+};
+
+// One direction of bidirectional_shortest_path
+struct SearchSide {
+    const CSRGraph& graph;
+    vector<int> distances;
+    vector<int> previous;   // Next vertex towards the side's root
+    IndexedDaryHeap<4> heap;
+
+    SearchSide(const CSRGraph& graph, int root)
+        : graph(graph), distances(graph.numVertices, INF), previous(graph.numVertices, -1), heap(graph.numVertices) {
+        distances[root] = 0;
+        heap.push(root, 0);
+    }
+};
+
+template <class GraphType>
+void batch(const GraphType& G, const vector<int>& sources, const DijkstraVisitor& visit, unsigned threads) {
+    for (int source : sources) {
+        check_vertex(source, G.numVertices);
+    }
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max<size_t>(1, min<size_t>(threads, sources.size()));
+
+    // Worker t takes sources t, t + threads, ... and the turns pass round the workers,
+    // so visit sees the sources in order while the other workers compute ahead
+    deque<binary_semaphore> turns;
+    for (unsigned t = 0; t < threads; ++t) {
+        turns.emplace_back(t == 0 ? 1 : 0);
+    }
+    atomic<bool> failed = false;
+    vector<future<void>> workers;
+    {
+        ThreadPool pool(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.push_back(pool.submit([&, t] {
+                DijkstraWorkspace workspace;
+                exception_ptr failure;
+                auto attempt = [&](auto step) {
+                    if (failed) return;
+                    try {
+                        step();
+                    } catch (...) {
+                        if (!failure) failure = current_exception();
+                        failed = true;
+                    }
+                };
+                // After a failure the turns still go round, so no worker waits forever
+                for (size_t i = t; i < sources.size(); i += threads) {
+                    attempt([&] { workspace.run(G, sources[i]); });
+                    turns[t].acquire();
+                    attempt([&] { visit(i, workspace.distances(), workspace.previous()); });
+                    turns[(t + 1) % threads].release();
+                }
+                if (failure) rethrow_exception(failure);
+            }));
+        }
+    }
+    for (future<void>& worker : workers) {
+        worker.get();
+    }
+}
+
+} // namespace
+
+void DijkstraWorkspace::run(const Graph& G, int source) {
+    if (heap_vertices != G.numVertices) {
+        heap = IndexedDaryHeap<4>(G.numVertices);
+        heap_vertices = G.numVertices;
+    }
+    run_dijkstra(G, source, distance_buffer, previous_buffer, visited, heap);
+}
+
+void DijkstraWorkspace::run(const CSRGraph& G, int source) {
+    if (heap_vertices != G.numVertices) {
+        heap = IndexedDaryHeap<4>(G.numVertices);
+        heap_vertices = G.numVertices;
+    }
+    run_dijkstra(G, source, distance_buffer, previous_buffer, visited, heap);
+}
+
+void dijkstra_batch(const Graph& G, const vector<int>& sources, const DijkstraVisitor& visit, unsigned threads) {
+    batch(G, sources, visit, threads);
+}
+
+void dijkstra_batch(const CSRGraph& G, const vector<int>& sources, const DijkstraVisitor& visit, unsigned threads) {
+    batch(G, sources, visit, threads);
+}
+
+template <EdgeWeight Weight>
+void parse_graph(string_view text, BasicGraph<Weight>& G) {
+    vector<BasicEdge<Weight>> edges = parse_edges<Weight>(text, G.numVertices);
+    G.assign(G.numVertices, {});
+    for (const BasicEdge<Weight>& edge : edges) {
+        G[edge.src].push_back(edge);
+    }
+}
+
+template <EdgeWeight Weight>
+void parse_graph(string_view text, BasicCSRGraph<Weight>& G) {
+    int numVertices;
+    vector<BasicEdge<Weight>> edges = parse_edges<Weight>(text, numVertices);
+    G = BasicCSRGraph<Weight>(numVertices, edges);
+}
+
+template <EdgeWeight Weight>
+void file_to_graph(const string& filename, BasicGraph<Weight>& G) {
+    MappedFile file(filename);
+    if (!is_binary_graph(file.text())) {
+        parse_graph(file.text(), G);
+        return;
+    }
+    CSRGraph packed = view_binary_graph(file.text(), filename);
+    G.numVertices = packed.numVertices;
+    G.assign(packed.numVertices, {});
+    for (int u = 0; u < packed.numVertices; ++u) {
+        for (int e = packed.offsets[u]; e < packed.offsets[u + 1]; ++e) {
+            G[u].emplace_back(u, packed.dst[e], Weight(packed.weight[e]));
+        }
+    }
+}
+
+template <EdgeWeight Weight>
+void file_to_graph(const string& filename, BasicCSRGraph<Weight>& G) {
+    auto file = make_shared<const MappedFile>(filename);
+    if (!is_binary_graph(file->text())) {
+        parse_graph(file->text(), G);
+        return;
+    }
+    CSRGraph packed = view_binary_graph(file->text(), filename);
+    if constexpr (is_same_v<Weight, int>) {
+        G = packed;
+        G.storage = move(file);
+    } else {
+        G = BasicCSRGraph<Weight>(vector<int>(packed.offsets.begin(), packed.offsets.end()),
+                                  vector<int>(packed.dst.begin(), packed.dst.end()),
+                                  vector<Weight>(packed.weight.begin(), packed.weight.end()));
+    }
+}
+
+void write_binary_graph(const CSRGraph& G, const string& filename) {
+    BinaryGraphHeader header = {};
+    memcpy(header.magic, BINARY_GRAPH_MAGIC, sizeof(BINARY_GRAPH_MAGIC));
+    header.version = BINARY_GRAPH_VERSION;
+    header.header_size = sizeof(header);
+    header.numVertices = G.numVertices;
+    header.numEdges = G.numEdges();
+    BinaryGraphLayout layout(header);
+
+    write_file_atomically(filename, "graph", [&](ofstream& out) {
+        auto write_at = [&](size_t offset, const void* data, size_t bytes) {
+            static const char padding[BINARY_GRAPH_ALIGNMENT] = {};
+            out.write(padding, offset - size_t(out.tellp()));
+            out.write(static_cast<const char*>(data), bytes);
+        };
+        write_at(0, &header, sizeof(header));
+        const int zero = 0;
+        span<const int> offsets = G.offsets.empty() ? span<const int>(&zero, 1) : G.offsets;
+        write_at(layout.offsets, offsets.data(), offsets.size_bytes());
+        write_at(layout.dst, G.dst.data(), G.dst.size_bytes());
+        write_at(layout.weight, G.weight.data(), G.weight.size_bytes());
+    });
+}
+
+void write_text_graph(const CSRGraph& G, const string& filename) {
+    ofstream out(filename, ios::trunc);
+    if (!out) {
+        throw runtime_error("Can't open graph file " + filename);
+    }
+    OutputBuffer buffer(out);
+    buffer.append(G.numVertices);
+    buffer.append("\n");
+    for (int u = 0; u < G.numVertices; ++u) {
+        for (int e = G.offsets[u]; e < G.offsets[u + 1]; ++e) {
+            buffer.append(u);
+            buffer.append(" ");
+            buffer.append(G.dst[e]);
+            buffer.append(" ");
+            buffer.append(G.weight[e]);
+            buffer.append("\n");
+        }
+    }
+    buffer.flush();
+    out.close();
+    if (!out) {
+        throw runtime_error("Can't write graph file " + filename);
+    }
+}
+
+template <EdgeWeight Weight>
+vector<Weight> dijkstra_shortest_path(const BasicGraph<Weight>& G, int source, vector<int>& previous,
+                                      DijkstraQueue queue) {
+    return dijkstra(G, source, previous, queue);
+}
+
+template <EdgeWeight Weight>
+vector<Weight> dijkstra_shortest_path(const BasicCSRGraph<Weight>& G, int source, vector<int>& previous,
+                                      DijkstraQueue queue) {
+    return dijkstra(G, source, previous, queue);
+}
+
+template <EdgeWeight Weight>
+vector<Weight> dijkstra_shortest_path(const BasicGraph<Weight>& G, int source, vector<int>& previous,
+                                      DijkstraStats& stats, DijkstraQueue queue) {
+    stats = {};
+    return dijkstra(G, source, previous, queue, -1, &stats);
+}
+
+template <EdgeWeight Weight>
+vector<Weight> dijkstra_shortest_path(const BasicCSRGraph<Weight>& G, int source, vector<int>& previous,
+                                      DijkstraStats& stats, DijkstraQueue queue) {
+    stats = {};
+    return dijkstra(G, source, previous, queue, -1, &stats);
+}
+
+string to_json(const DijkstraStats& stats) {
+    return "{\"heap_pushes\": " + to_string(stats.heap_pushes) + ", \"stale_pops\": " + to_string(stats.stale_pops)
+           + ", \"relaxations\": " + to_string(stats.relaxations) + ", \"settled\": " + to_string(stats.settled) + "}";
+}
+
+ShortestPath shortest_path(const Graph& G, int source, int target, DijkstraQueue queue) {
+    DijkstraStats stats;
+    return point_to_point(G, source, target, queue, stats);
+}
+
+ShortestPath shortest_path(const CSRGraph& G, int source, int target, DijkstraQueue queue) {
+    DijkstraStats stats;
+    return point_to_point(G, source, target, queue, stats);
+}
+
+ShortestPath shortest_path(const Graph& G, int source, int target, DijkstraStats& stats, DijkstraQueue queue) {
+    return point_to_point(G, source, target, queue, stats);
+}
+
+ShortestPath shortest_path(const CSRGraph& G, int source, int target, DijkstraStats& stats, DijkstraQueue queue) {
+    return point_to_point(G, source, target, queue, stats);
+}
+
+CSRGraph reverse_graph(const CSRGraph& G) {
+    vector<Edge> edges;
+    edges.reserve(G.numEdges());
+    for (int u = 0; u < G.numVertices; ++u) {
+        for (int i = G.offsets[u]; i < G.offsets[u + 1]; ++i) {
+            edges.emplace_back(G.dst[i], u, G.weight[i]);
+        }
+    }
+    return CSRGraph(G.numVertices, edges);
+}
+
+ShortestPath bidirectional_shortest_path(const CSRGraph& G, const CSRGraph& reversed, int source, int target) {
+    if (reversed.numVertices != G.numVertices) {
+        throw runtime_error("Reverse graph has " + to_string(reversed.numVertices) + " vertices, expected "
+                            + to_string(G.numVertices));
+    }
+    check_vertex(source, G.numVertices);
+    check_vertex(target, G.numVertices);
+    SearchSide forward(G, source), backward(reversed, target);
+    ShortestPath result;
+    int meeting = -1;
+    bool overflowed = false;
+    if (source == target) {
+        result.distance = 0;
+        meeting = source;
+    }
+
+    while (!forward.heap.empty() && !backward.heap.empty()) {
+        if (int64_t(forward.heap.min_key()) + backward.heap.min_key() >= result.distance) {
+            break;
+        }
+        bool ahead = forward.heap.min_key() <= backward.heap.min_key();
+        SearchSide& side = ahead ? forward : backward;
+        const SearchSide& other = ahead ? backward : forward;
+
+        int u = side.heap.pop();
+        ++result.settled;
+        for (int i = side.graph.offsets[u]; i < side.graph.offsets[u + 1]; ++i) {
+            int v = side.graph.dst[i];
+            int distance;
+            if (!add_path_length(side.distances[u], side.graph.weight[i], distance)) {
+                overflowed = true;
+                continue;
+            }
+            if (distance >= side.distances[v]) {
+                continue;
+            }
+            side.distances[v] = distance;
+            side.previous[v] = u;
+            side.heap.push(v, distance);
+            if (other.distances[v] != INF) {
+                int length;
+                if (!add_path_length(distance, other.distances[v], length)) {
+                    overflowed = true;
+                } else if (length < result.distance) {
+                    result.distance = length;
+                    meeting = v;
+                }
+            }
+        }
+    }
+    // Overflowing sums only ever skip paths too long for int. If that leaves no path,
+    // the one-sided search decides between none and one too long to represent.
+    if (meeting == -1 && overflowed) {
+        return shortest_path(G, source, target);
+    }
+
+    if (meeting != -1) {
+        for (int v = meeting; v != -1; v = forward.previous[v]) {
+            result.path.push_back(v);
+        }
+        reverse(result.path.begin(), result.path.end());
+        for (int v = backward.previous[meeting]; v != -1; v = backward.previous[v]) {
+            result.path.push_back(v);
+        }
+    }
+    return result;
+}
+
+ShortestPath bidirectional_shortest_path(const CSRGraph& G, int source, int target) {
+    return bidirectional_shortest_path(G, reverse_graph(G), source, target);
+}
+
+template <EdgeWeight Weight>
+vector<int> extract_shortest_path(const vector<Weight>& distances, const vector<int>& previous, int destination) {
     vector<int> path;
     
-    if (distances[destination] == INF) {
+    if (distances[destination] == INF_WEIGHT<Weight>) {
         return path;
     }
     for (int vertex = destination; vertex != -1; vertex = previous[vertex]) {
@@ -63,3 +770,69 @@ void print_path(const vector<int>& path, int total) {
     
     cout << " \nTotal cost is " << total << endl;
 }
+
+void write_shortest_paths(ostream& out, const vector<int>& distances, const vector<int>& previous,
+                          const vector<int>& destinations) {
+    for (int dest : destinations) {
+        check_vertex(dest, distances.size());
+    }
+    OutputBuffer buffer(out);
+    vector<int> path;
+    for (int dest : destinations) {
+        buffer.append("To vertex ");
+        buffer.append(dest);
+        if (distances[dest] == INF) {
+            buffer.append(": No path exists\n");
+            continue;
+        }
+        path.clear();
+        for (int vertex = dest; vertex != -1; vertex = previous[vertex]) {
+            path.push_back(vertex);
+        }
+        buffer.append(": ");
+        for (auto vertex = path.rbegin(); vertex != path.rend(); ++vertex) {
+            buffer.append(*vertex);
+            buffer.append(vertex + 1 != path.rend() ? " " : " \nTotal cost is ");
+        }
+        buffer.append(distances[dest]);
+        buffer.append("\n");
+    }
+    buffer.flush();
+}
+
+void write_shortest_path_tree(ostream& out, const vector<int>& distances, const vector<int>& previous) {
+    OutputBuffer buffer(out);
+    for (size_t v = 0; v < distances.size(); ++v) {
+        buffer.append(int(v));
+        buffer.append(" ");
+        buffer.append(previous[v]);
+        buffer.append(" ");
+        if (distances[v] == INF) buffer.append("-");
+        else buffer.append(distances[v]);
+        buffer.append("\n");
+    }
+    buffer.flush();
+}
+
+// The weight types of EdgeWeight, compiled here once for the whole program
+#define INSTANTIATE_FOR_WEIGHT(Weight)                                                                        \
+    template struct BasicCSRGraph<Weight>;                                                                    \
+    template void parse_graph(string_view, BasicGraph<Weight>&);                                              \
+    template void parse_graph(string_view, BasicCSRGraph<Weight>&);                                           \
+    template void file_to_graph(const string&, BasicGraph<Weight>&);                                          \
+    template void file_to_graph(const string&, BasicCSRGraph<Weight>&);                                       \
+    template vector<Weight> dijkstra_shortest_path(const BasicGraph<Weight>&, int, vector<int>&, DijkstraQueue); \
+    template vector<Weight> dijkstra_shortest_path(const BasicCSRGraph<Weight>&, int, vector<int>&,           \
+                                                   DijkstraQueue);                                            \
+    template vector<Weight> dijkstra_shortest_path(const BasicGraph<Weight>&, int, vector<int>&, DijkstraStats&, \
+                                                   DijkstraQueue);                                            \
+    template vector<Weight> dijkstra_shortest_path(const BasicCSRGraph<Weight>&, int, vector<int>&,           \
+                                                   DijkstraStats&, DijkstraQueue);                            \
+    template vector<int> extract_shortest_path(const vector<Weight>&, const vector<int>&, int);
+
+INSTANTIATE_FOR_WEIGHT(int)
+INSTANTIATE_FOR_WEIGHT(int64_t)
+INSTANTIATE_FOR_WEIGHT(float)
+INSTANTIATE_FOR_WEIGHT(double)
+
+#undef INSTANTIATE_FOR_WEIGHT
@@ -1,52 +1,297 @@
+#pragma once
+
+#include <functional>
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <queue>
+#include <concepts>
+#include <cstdint>
 #include <limits>
+#include <memory>
+#include <span>
 #include <stack>
+#include <string>
+#include <string_view>
+#include "priority_queues.h"
+#include "stats.h"
 
 using namespace std;
 
-constexpr int INF = numeric_limits<int>::max();
+// Edge weight types the graphs, dijkstra_shortest_path and extract_shortest_path are
+// compiled for (see the end of dijkstras.cpp). int is the Edge, Graph and CSRGraph
+// used everywhere else; pick the narrowest type whose range covers the longest path.
+// A path length that doesn't fit throws instead of wrapping around.
+template <class Weight>
+concept EdgeWeight = same_as<Weight, int> || same_as<Weight, int64_t> || same_as<Weight, float>
+                     || same_as<Weight, double>;
+
+// Distance of an unreachable vertex: infinity for floating-point weights, else the largest value
+template <EdgeWeight Weight>
+constexpr Weight INF_WEIGHT = numeric_limits<Weight>::has_infinity ? numeric_limits<Weight>::infinity()
+                                                                   : numeric_limits<Weight>::max();
+
+constexpr int INF = INF_WEIGHT<int>;
+
+// distance + weight in sum, or false if it doesn't fit below INF_WEIGHT, which marks
+// unreachable vertices. Such a sum can never improve a distance, so every search skips
+// the relaxation rather than failing.
+template <EdgeWeight Weight>
+bool add_path_length(Weight distance, Weight weight, Weight& sum) {
+    if constexpr (is_integral_v<Weight>) {
+        if (__builtin_add_overflow(distance, weight, &sum)) return false;
+    } else {
+        sum = distance + weight;
+    }
+    return sum < INF_WEIGHT<Weight>;
+}
 
-struct Edge {
+template <EdgeWeight Weight>
+struct BasicEdge {
     int src=0;
     int dst=0;
-    int weight=0;
-    Edge(int s = 0, int d = 0, int w = 0) : src(s), dst(d), weight(w) {}
-    friend istream& operator>>(istream& in, Edge& e)
+    Weight weight=0;
+    BasicEdge(int s = 0, int d = 0, Weight w = 0) : src(s), dst(d), weight(w) {}
+    friend istream& operator>>(istream& in, BasicEdge& e)
     {
         return in >> e.src >> e.dst >> e.weight;
     }
 
-    friend ostream& operator<<(ostream& out, const Edge& e)
+    friend ostream& operator<<(ostream& out, const BasicEdge& e)
     {
         return out << "(" << e.src << "," << e.dst << "," << e.weight << ")";
     }
 };
 
-struct Graph : public vector<vector<Edge>> {
+using Edge = BasicEdge<int>;
+
+template <EdgeWeight Weight>
+struct BasicGraph : public vector<vector<BasicEdge<Weight>>> {
+    using weight_type = Weight;
     int numVertices=0;
 };
 
-inline istream& operator>>(istream& in, Graph& G) {
+using Graph = BasicGraph<int>;
+
+template <EdgeWeight Weight>
+void check_edge(const BasicEdge<Weight>& e, int numVertices) {
+    if (e.src < 0 || e.src >= numVertices || e.dst < 0 || e.dst >= numVertices)
+        throw runtime_error("Edge " + to_string(e.src) + " -> " + to_string(e.dst) + " is out of range for "
+                            + to_string(numVertices) + " vertices");
+}
+
+inline void check_vertex(int vertex, int numVertices) {
+    if (vertex < 0 || vertex >= numVertices)
+        throw runtime_error("Vertex " + to_string(vertex) + " is out of range for " + to_string(numVertices)
+                            + " vertices");
+}
+
+template <EdgeWeight Weight>
+istream& operator>>(istream& in, BasicGraph<Weight>& G) {
     if (!(in >> G.numVertices))
         throw runtime_error("Unable to find input file");
     G.resize(G.numVertices);
-    for (Edge e; in >> e;)
+    for (BasicEdge<Weight> e; in >> e;) {
+        check_edge(e, G.numVertices);
         G[e.src].push_back(e);
+    }
     return in;
 }
 
-inline void file_to_graph(const string& filename, Graph& G) {
-    ifstream in(filename);
-    if (!in) {
-        throw runtime_error("Can't open input file");
-    }
-    in >> G;
-    in.close();
+// Compressed sparse row form of a graph: the out-edges of vertex u are entries
+// offsets[u] .. offsets[u + 1] - 1 of the packed dst and weight arrays, in input order.
+// One contiguous allocation per array and 4 + sizeof(Weight) bytes per edge, instead of
+// one vector per vertex and an Edge that repeats its source.
+//
+// The arrays are read-only views of storage shared by all copies of the graph: vectors
+// the graph built itself, or a memory-mapped binary graph file (see write_binary_graph).
+// Copies are cheap, and a mapped graph is never read into memory up front.
+template <EdgeWeight Weight>
+struct BasicCSRGraph {
+    using weight_type = Weight;
+    int numVertices=0;
+    span<const int> offsets;
+    span<const int> dst;
+    span<const Weight> weight;
+    shared_ptr<const void> storage;   // Keeps the arrays alive
+
+    BasicCSRGraph() = default;
+    explicit BasicCSRGraph(const BasicGraph<Weight>& G);
+    BasicCSRGraph(int n, const vector<BasicEdge<Weight>>& edges);
+    // Takes over ready-made arrays; numVertices is offsets.size() - 1
+    BasicCSRGraph(vector<int> offsets, vector<int> dst, vector<Weight> weight);
+
+    int numEdges() const { return dst.size(); }
+};
+
+using CSRGraph = BasicCSRGraph<int>;
+
+template <EdgeWeight Weight>
+istream& operator>>(istream& in, BasicCSRGraph<Weight>& G) {
+    int numVertices;
+    if (!(in >> numVertices))
+        throw runtime_error("Unable to find input file");
+    vector<BasicEdge<Weight>> edges;
+    for (BasicEdge<Weight> e; in >> e;)
+        edges.push_back(e);
+    G = BasicCSRGraph<Weight>(numVertices, edges);
+    return in;
 }
 
-vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous);
-vector<int> extract_shortest_path(const vector<int>& /*distances*/, const vector<int>& previous, int destination);
+// Bulk parsers for the text format ("numVertices" then "src dst weight" triples): the
+// numbers are read with from_chars and the edge arrays are sized up front from a token
+// count. Malformed numbers, a dangling partial edge and out-of-range vertices all throw.
+template <EdgeWeight Weight>
+void parse_graph(string_view text, BasicGraph<Weight>& G);
+template <EdgeWeight Weight>
+void parse_graph(string_view text, BasicCSRGraph<Weight>& G);
+
+// Memory-maps the file. Binary graph files are used in place by the CSRGraph overload
+// (and copied, converting the int weights, into the others); anything else is run
+// through parse_graph.
+template <EdgeWeight Weight>
+void file_to_graph(const string& filename, BasicGraph<Weight>& G);
+template <EdgeWeight Weight>
+void file_to_graph(const string& filename, BasicCSRGraph<Weight>& G);
+
+// Binary graph file (int weights only), little-endian, each part starting on a BINARY_GRAPH_ALIGNMENT
+// byte boundary:
+//
+//   header    magic "HW9GRAPH", uint32 version, uint32 header size, uint64 vertex count,
+//             uint64 edge count
+//   offsets   vertex count + 1 int32
+//   dst       edge count int32
+//   weight    edge count int32
+//
+// Opening checks the header and the file size, then makes one pass over offsets and dst
+// so that every edge range and head vertex is in bounds; a damaged file throws
+// runtime_error rather than being mapped.
+constexpr size_t BINARY_GRAPH_ALIGNMENT = 64;
+
+// Writes G in the binary format through a temporary file and a rename; throws
+// runtime_error on failure
+void write_binary_graph(const CSRGraph& G, const string& filename);
+
+// Writes G in the text format parse_graph reads: the vertex count, then one
+// "source destination weight" line per edge. Throws runtime_error on failure.
+void write_text_graph(const CSRGraph& G, const string& filename);
+
+// Priority queue behind dijkstra_shortest_path (see priority_queues.h). Radix and Dial
+// need non-negative weights and throw runtime_error otherwise.
+enum class DijkstraQueue {
+    LazyBinary,   // Binary heap that re-pushes improved vertices and skips stale entries
+    IndexedDary,  // 4-ary heap with decrease-key, at most one entry per vertex
+    Radix,        // Monotone radix heap on the integer distances
+    Dial,         // Circular bucket array with one bucket per possible edge weight
+    Auto          // Dial when the largest weight is at most DIAL_MAX_WEIGHT, else Radix;
+                  // LazyBinary if any weight is negative
+};
+
+constexpr int DIAL_MAX_WEIGHT = 1024;
+
+// Distances from source, INF_WEIGHT<Weight> for unreachable vertices. Radix and Dial
+// take int weights only; Auto picks LazyBinary for the other types. Throws
+// runtime_error if source is out of range or a reachable vertex's distance doesn't fit
+// in Weight; longer paths that overflow are simply not taken.
+template <EdgeWeight Weight>
+vector<Weight> dijkstra_shortest_path(const BasicGraph<Weight>& G, int source, vector<int>& previous,
+                                      DijkstraQueue queue = DijkstraQueue::LazyBinary);
+template <EdgeWeight Weight>
+vector<Weight> dijkstra_shortest_path(const BasicCSRGraph<Weight>& G, int source, vector<int>& previous,
+                                      DijkstraQueue queue = DijkstraQueue::LazyBinary);
+
+// Work done by one Dijkstra run. settled is always counted; the rest only when
+// STATS_ENABLED (see stats.h).
+struct DijkstraStats {
+    size_t heap_pushes = 0;   // Pushes, counting a decrease-key of a queued vertex as one
+    size_t stale_pops = 0;    // Pops of already settled vertices, from the lazy queues
+    size_t relaxations = 0;   // Edges scanned out of settled vertices
+    size_t settled = 0;       // Vertices whose distance became final
+};
+
+// Same, also filling in stats for this run
+template <EdgeWeight Weight>
+vector<Weight> dijkstra_shortest_path(const BasicGraph<Weight>& G, int source, vector<int>& previous,
+                                      DijkstraStats& stats, DijkstraQueue queue = DijkstraQueue::LazyBinary);
+template <EdgeWeight Weight>
+vector<Weight> dijkstra_shortest_path(const BasicCSRGraph<Weight>& G, int source, vector<int>& previous,
+                                      DijkstraStats& stats, DijkstraQueue queue = DijkstraQueue::LazyBinary);
+
+// One line of JSON with every counter, e.g. {"heap_pushes": 5, ...}
+string to_json(const DijkstraStats& stats);
+
+// Answer to a point-to-point query. distance is INF and path is empty when target is
+// unreachable; settled counts the vertices the search finalized.
+struct ShortestPath {
+    int distance = INF;
+    vector<int> path;
+    int settled = 0;
+};
+
+// Dijkstra from source that stops once target is settled. Gives the same distance and
+// path as dijkstra_shortest_path + extract_shortest_path with the same queue.
+ShortestPath shortest_path(const Graph& G, int source, int target,
+                           DijkstraQueue queue = DijkstraQueue::LazyBinary);
+ShortestPath shortest_path(const CSRGraph& G, int source, int target,
+                           DijkstraQueue queue = DijkstraQueue::LazyBinary);
+ShortestPath shortest_path(const Graph& G, int source, int target, DijkstraStats& stats,
+                           DijkstraQueue queue = DijkstraQueue::LazyBinary);
+ShortestPath shortest_path(const CSRGraph& G, int source, int target, DijkstraStats& stats,
+                           DijkstraQueue queue = DijkstraQueue::LazyBinary);
+
+// Buffers kept between single-source runs, so repeated queries on graphs of the same
+// size don't allocate. run() gives the same distances and previous tree as
+// dijkstra_shortest_path(G, source, previous); the indexed heap breaks ties the same way.
+class DijkstraWorkspace {
+public:
+    void run(const Graph& G, int source);
+    void run(const CSRGraph& G, int source);
+
+    const vector<int>& distances() const { return distance_buffer; }
+    const vector<int>& previous() const { return previous_buffer; }
+
+private:
+    vector<int> distance_buffer;
+    vector<int> previous_buffer;
+    vector<bool> visited;
+    IndexedDaryHeap<4> heap{0};
+    int heap_vertices = 0;
+};
+
+// Called with the index into sources and that source's distances and previous tree;
+// the vectors are only valid during the call
+using DijkstraVisitor = function<void(size_t index, const vector<int>& distances, const vector<int>& previous)>;
+
+// Runs Dijkstra from every source on a thread pool with one DijkstraWorkspace per worker
+// (0 threads means one per hardware thread). visit is called once per source, in source
+// order and never concurrently, while the other workers carry on with later sources.
+// Exceptions from visit stop the batch and are rethrown.
+void dijkstra_batch(const Graph& G, const vector<int>& sources, const DijkstraVisitor& visit, unsigned threads = 0);
+void dijkstra_batch(const CSRGraph& G, const vector<int>& sources, const DijkstraVisitor& visit, unsigned threads = 0);
+
+// The graph with every edge u -> v turned into v -> u, same weight
+CSRGraph reverse_graph(const CSRGraph& G);
+
+// Bidirectional Dijkstra: searches forward from source on G and backward from target on
+// its reverse, always advancing the side with the smaller key, and stops when the two
+// smallest keys add up to at least the best source-target distance seen. Needs
+// non-negative weights. The distance matches shortest_path; so does the path when the
+// shortest path is unique, otherwise it is another path of the same length.
+ShortestPath bidirectional_shortest_path(const CSRGraph& G, const CSRGraph& reversed, int source, int target);
+ShortestPath bidirectional_shortest_path(const CSRGraph& G, int source, int target);
+
+template <EdgeWeight Weight>
+vector<int> extract_shortest_path(const vector<Weight>& distances, const vector<int>& previous, int destination);
 void print_path(const vector<int>& v, int total);
+
+// The path to each destination in print_path's format, after "To vertex d: ", or "To
+// vertex d: No path exists". Paths are walked straight from previous into one reusable
+// buffer that reaches out in a few large writes, so there is no vector or flush per
+// destination.
+void write_shortest_paths(ostream& out, const vector<int>& distances, const vector<int>& previous,
+                          const vector<int>& destinations);
+
+// The shortest-path tree itself, one "vertex previous distance" line per vertex with
+// -1 for no previous and "-" for an unreachable vertex. Linear in the vertex count,
+// however deep the paths are.
+void write_shortest_path_tree(ostream& out, const vector<int>& distances, const vector<int>& previous);
@@ -1,39 +1,302 @@
 #include "dijkstras.h"
+#include "contraction_hierarchy.h"
+#include "landmarks.h"
+#include "delta_stepping.h"
+#include "generators.h"
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <random>
+#include <thread>
 
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        cerr << "Usage: " << argv[0] << " <graph_file>" << endl;
+static void bench_graph(const string& name, const CSRGraph& G, int runs) {
+    const pair<DijkstraQueue, const char*> queues[] = {{DijkstraQueue::LazyBinary, "lazy binary heap"},
+                                                       {DijkstraQueue::IndexedDary, "indexed 4-ary heap"},
+                                                       {DijkstraQueue::Radix, "radix heap"},
+                                                       {DijkstraQueue::Dial, "Dial buckets"}};
+    cout << name << " graph: " << G.numVertices << " vertices, " << G.numEdges() << " edges" << endl;
+    for (auto [queue, queue_name] : queues) {
+        vector<double> times;
+        vector<int> previous;
+        for (int run = 0; run < runs; ++run) {
+            auto start = chrono::steady_clock::now();
+            dijkstra_shortest_path(G, run % G.numVertices, previous, queue);
+            times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        }
+        sort(times.begin(), times.end());
+        cout << "  " << queue_name << ": min " << times.front() << " ms, median " << times[runs / 2] << " ms" << endl;
+    }
+}
+
+static int bench_queues(int numVertices, int runs) {
+    bench_graph("Sparse", random_graph(numVertices, 4, 1), runs);
+    int denseVertices = max(2, numVertices / 50);
+    bench_graph("Dense", random_graph(denseVertices, max(1, denseVertices / 2), 2), runs);
+    return 0;
+}
+
+// Answers one query from the contraction hierarchy cached next to the graph file,
+// building and saving it first if the cache is missing or stale
+static int hierarchy_query(const string& filename, int source, int target) {
+    try {
+        CSRGraph G;
+        file_to_graph(filename, G);
+        auto hierarchy = load_contraction_hierarchy(G, filename + ".ch");
+        ShortestPath result = hierarchy->query(source, target);
+        cout << "Shortest path from vertex " << source << " to vertex " << target << ":" << endl;
+        if (result.distance == INF) {
+            cout << "No path exists" << endl;
+        } else {
+            print_path(result.path, result.distance);
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Compares ALT with plain early-exit Dijkstra on random source/target pairs, reporting
+// average settled vertices and query times for tuning the landmark count
+static int compare_alt(const string& filename, int count, int queries) {
+    try {
+        if (queries <= 0) {
+            throw runtime_error("Need at least one query, not " + to_string(queries));
+        }
+        CSRGraph G;
+        file_to_graph(filename, G);
+        if (G.numVertices == 0) {
+            throw runtime_error("Graph " + filename + " has no vertices to query");
+        }
+        auto start = chrono::steady_clock::now();
+        Landmarks landmarks(G, count);
+        double build_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        mt19937 rng(1);
+        uniform_int_distribution<int> vertex(0, G.numVertices - 1);
+        long long dijkstra_settled = 0, alt_settled = 0;
+        double dijkstra_ms = 0, alt_ms = 0;
+        for (int q = 0; q < queries; ++q) {
+            int source = vertex(rng), target = vertex(rng);
+            start = chrono::steady_clock::now();
+            ShortestPath plain = shortest_path(G, source, target);
+            auto middle = chrono::steady_clock::now();
+            ShortestPath guided = alt_shortest_path(G, landmarks, source, target);
+            auto end = chrono::steady_clock::now();
+            if (guided.distance != plain.distance) {
+                throw runtime_error("ALT distance differs from Dijkstra for " + to_string(source) + " -> "
+                                    + to_string(target));
+            }
+            dijkstra_settled += plain.settled;
+            alt_settled += guided.settled;
+            dijkstra_ms += chrono::duration<double, milli>(middle - start).count();
+            alt_ms += chrono::duration<double, milli>(end - middle).count();
+        }
+        cout << landmarks.count() << " landmarks built in " << build_ms << " ms" << endl;
+        cout << "  Dijkstra: " << double(dijkstra_settled) / queries << " settled, " << dijkstra_ms / queries
+             << " ms per query" << endl;
+        cout << "  ALT:      " << double(alt_settled) / queries << " settled, " << alt_ms / queries
+             << " ms per query" << endl;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
         return 1;
     }
+    return 0;
+}
 
-    string filename = argv[1];
-    Graph G;
+// Vertices listed in a file, on stdin for "-", or every vertex for "all"
+static vector<int> read_vertices(const string& spec, int numVertices) {
+    vector<int> vertices;
+    if (spec == "all") {
+        for (int v = 0; v < numVertices; ++v) vertices.push_back(v);
+    } else if (spec == "-") {
+        for (int v; cin >> v;) vertices.push_back(v);
+    } else {
+        ifstream in(spec);
+        if (!in) throw runtime_error("Can't open vertex list " + spec);
+        for (int v; in >> v;) vertices.push_back(v);
+    }
+    return vertices;
+}
 
+// Shortest paths from source to the listed destinations, in the default report's format
+static int run_paths(const string& filename, int source, const string& destinations_file) {
     try {
+        CSRGraph G;
         file_to_graph(filename, G);
-        int source = 0;
+        vector<int> destinations = read_vertices(destinations_file, G.numVertices);
         vector<int> previous;
         vector<int> distances = dijkstra_shortest_path(G, source, previous);
-        cout << "Shortest paths from vertex " << source << ":" << endl;
-        for (int dest = 0; dest < G.numVertices; ++dest) {
-            if (distances[dest] == INF) {
-                cout << "To vertex " << dest << ": No path exists" << endl;
+        cout << "Shortest paths from vertex " << source << ":\n";
+        write_shortest_paths(cout, distances, previous, destinations);
+        cout.flush();
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// The shortest-path tree from source, for tools that rebuild paths themselves
+static int run_tree(const string& filename, int source) {
+    try {
+        CSRGraph G;
+        file_to_graph(filename, G);
+        vector<int> previous;
+        vector<int> distances = dijkstra_shortest_path(G, source, previous);
+        write_shortest_path_tree(cout, distances, previous);
+        cout.flush();
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Distances from each listed source (or from every vertex for "all"), one line per
+// source in input order: "source: d0 d1 ...", with "-" for unreachable vertices
+static int run_sources(const string& filename, const string& sources_file, unsigned threads) {
+    try {
+        CSRGraph G;
+        file_to_graph(filename, G);
+        vector<int> sources = read_vertices(sources_file, G.numVertices);
+
+        string line;
+        dijkstra_batch(G, sources, [&](size_t i, const vector<int>& distances, const vector<int>&) {
+            line = to_string(sources[i]) + ":";
+            for (int distance : distances) {
+                line += ' ';
+                line += distance == INF ? "-" : to_string(distance);
+            }
+            line += '\n';
+            cout << line;
+        }, threads);
+        cout.flush();
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Times Dijkstra and delta stepping (auto-tuned delta, then a few fixed widths) on a
+// random graph with 1, 2, 4, ... up to max_threads threads
+static int bench_delta(int numVertices, unsigned max_threads, int runs) {
+    CSRGraph G = random_graph(numVertices, 4, 3);
+    auto time_ms = [&](auto search) {
+        vector<double> times;
+        for (int run = 0; run < runs; ++run) {
+            auto start = chrono::steady_clock::now();
+            search();
+            times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        }
+        sort(times.begin(), times.end());
+        return times[runs / 2];
+    };
+    vector<int> previous;
+    cout << "Graph: " << G.numVertices << " vertices, " << G.numEdges() << " edges" << endl;
+    cout << "  dijkstra: " << time_ms([&] { dijkstra_shortest_path(G, 0, previous); }) << " ms" << endl;
+    int tuned = tune_delta(G);
+    for (int delta : {tuned, tuned * 4, tuned * 16}) {
+        for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+            double ms = time_ms([&] { delta_stepping_shortest_path(G, 0, previous, {delta, threads}); });
+            cout << "  delta stepping, delta " << delta << (delta == tuned ? " (auto)" : "") << ", " << threads
+                 << " threads: " << ms << " ms" << endl;
+        }
+    }
+    return 0;
+}
+
+// Converts a text graph file to the binary format that file_to_graph maps in place
+static int convert_graph(const string& text_file, const string& binary_file) {
+    try {
+        CSRGraph G;
+        file_to_graph(text_file, G);
+        write_binary_graph(G, binary_file);
+        cout << "Wrote " << G.numVertices << " vertices and " << G.numEdges() << " edges to " << binary_file << endl;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Arguments are parsed under the try too, so a malformed number is reported, not fatal
+    try {
+        string mode = argc > 1 ? argv[1] : "";
+        if (mode == "--bench-queues") {
+            return bench_queues(argc > 2 ? max(1, stoi(argv[2])) : 100000, argc > 3 ? max(1, stoi(argv[3])) : 5);
+        }
+        if (argc == 4 && mode == "--convert") {
+            return convert_graph(argv[2], argv[3]);
+        }
+        if (mode == "--bench-delta") {
+            unsigned max_threads = argc > 3 ? max(1, stoi(argv[3])) : max(1u, thread::hardware_concurrency());
+            return bench_delta(argc > 2 ? max(1, stoi(argv[2])) : 1000000, max_threads,
+                               argc > 4 ? max(1, stoi(argv[4])) : 3);
+        }
+        if (argc >= 3 && argc <= 5 && mode == "--sources") {
+            return run_sources(argv[2], argc > 3 ? argv[3] : "all", argc > 4 ? stoul(argv[4]) : 0);
+        }
+        if (argc >= 3 && argc <= 5 && mode == "--alt") {
+            return compare_alt(argv[2], argc > 3 ? stoi(argv[3]) : 16, argc > 4 ? stoi(argv[4]) : 100);
+        }
+        if (argc >= 4 && argc <= 5 && mode == "--paths") {
+            return run_paths(argv[2], stoi(argv[3]), argc > 4 ? argv[4] : "all");
+        }
+        if (argc >= 3 && argc <= 4 && mode == "--tree") {
+            return run_tree(argv[2], argc > 3 ? stoi(argv[3]) : 0);
+        }
+        if (argc == 5 && mode == "--ch") {
+            return hierarchy_query(argv[2], stoi(argv[3]), stoi(argv[4]));
+        }
+        // --stats also writes the search's DijkstraStats to stderr as JSON
+        const string program = argv[0];
+        bool print_stats = mode == "--stats";
+        if (print_stats) {
+            --argc;
+            ++argv;
+        }
+        if (argc != 2 && argc != 4) {
+            cerr << "Usage: " << program << " [--stats] <graph_file> [source target] | --convert <text_file> <binary_file>"
+                 << " | --ch <graph_file> <source> <target>"
+                 << " | --paths <graph_file> <source> [destinations_file|-|all] | --tree <graph_file> [source]"
+                 << " | --sources <graph_file> [sources_file|-|all] [threads]"
+                 << " | --alt <graph_file> [landmarks] [queries] | --bench-queues [vertices] [runs]"
+                 << " | --bench-delta [vertices] [max_threads] [runs]" << endl;
+            return 1;
+        }
+
+        string filename = argv[1];
+        CSRGraph G;
+        file_to_graph(filename, G);
+        if (argc == 4) {
+            // One destination: stop as soon as it is settled
+            int source = stoi(argv[2]), target = stoi(argv[3]);
+            DijkstraStats stats;
+            ShortestPath result = shortest_path(G, source, target, stats);
+            cout << "Shortest path from vertex " << source << " to vertex " << target << ":" << endl;
+            if (result.distance == INF) {
+                cout << "No path exists" << endl;
             } else {
-                vector<int> path = extract_shortest_path(distances, previous, dest);
-                cout << "To vertex " << dest << ": ";
-
-                for (size_t i = 0; i < path.size(); ++i) {
-                    cout << path[i];
-                    if (i < path.size() - 1) {
-                        cout << " ";
-                    }
-                }
-                cout << " \nTotal cost is " << distances[dest] << endl;
+                print_path(result.path, result.distance);
             }
+            if (print_stats) cerr << to_json(stats) << endl;
+            return 0;
         }
-        
+        int source = 0;
+        vector<int> previous;
+        DijkstraStats stats;
+        vector<int> distances = dijkstra_shortest_path(G, source, previous, stats);
+        cout << "Shortest paths from vertex " << source << ":\n";
+        vector<int> destinations(G.numVertices);
+        iota(destinations.begin(), destinations.end(), 0);
+        write_shortest_paths(cout, distances, previous, destinations);
+        cout.flush();
+        if (print_stats) cerr << to_json(stats) << endl;
     } catch (const exception& e) {
         cerr << "Error: " << e.what() << endl;
         return 1;
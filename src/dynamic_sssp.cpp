@@ -0,0 +1,170 @@
+#include "dynamic_sssp.h"
+#include <algorithm>
+#include <functional>
+
+DynamicShortestPaths::DynamicShortestPaths(const CSRGraph& G, int source)
+    : root(source), out(G.numVertices), in(G.numVertices) {
+    check_vertex(source, G.numVertices);
+    for (int u = 0; u < G.numVertices; ++u) {
+        for (int e = G.offsets[u]; e < G.offsets[u + 1]; ++e) {
+            check(u, G.dst[e], G.weight[e]);
+            out[u].push_back({G.dst[e], G.weight[e]});
+            in[G.dst[e]].push_back({u, G.weight[e]});
+        }
+    }
+    dist = dijkstra_shortest_path(G, source, prev);
+}
+
+void DynamicShortestPaths::insert_edge(int u, int v, int weight) {
+    check(u, v, weight);
+    out[u].push_back({v, weight});
+    in[v].push_back({u, weight});
+    settled = 0;
+    lowered(u, v, weight);
+    check_overflow();
+}
+
+void DynamicShortestPaths::remove_edge(int u, int v) {
+    check(u, v, 0);
+    erase(out[u], v);
+    erase(in[v], u);
+    settled = 0;
+    raised(u, v);
+    check_overflow();
+}
+
+void DynamicShortestPaths::set_weight(int u, int v, int weight) {
+    check(u, v, weight);
+    erase(out[u], v);
+    erase(in[v], u);
+    out[u].push_back({v, weight});
+    in[v].push_back({u, weight});
+    // Dearer first: if the old edge was tight, v's subtree is rebuilt without it, and
+    // then the new weight can only lower distances
+    settled = 0;
+    raised(u, v);
+    lowered(u, v, weight);
+    check_overflow();
+}
+
+CSRGraph DynamicShortestPaths::graph() const {
+    vector<Edge> edges;
+    for (int u = 0; u < numVertices(); ++u) {
+        for (const Arc& arc : out[u]) {
+            edges.emplace_back(u, arc.vertex, arc.weight);
+        }
+    }
+    return CSRGraph(numVertices(), edges);
+}
+
+void DynamicShortestPaths::check(int u, int v, int weight) const {
+    check_edge(Edge(u, v, weight), numVertices());
+    if (weight < 0) {
+        throw runtime_error("Dynamic shortest paths need non-negative edge weights");
+    }
+}
+
+void DynamicShortestPaths::erase(vector<Arc>& arcs, int vertex) {
+    erase_if(arcs, [vertex](const Arc& arc) { return arc.vertex == vertex; });
+}
+
+// The edge u -> v of this weight is new or cheaper
+void DynamicShortestPaths::lowered(int u, int v, int weight) {
+    int distance;
+    if (dist[u] == INF || !relax(u, v, weight, distance) || distance >= dist[v]) {
+        return;
+    }
+    dist[v] = distance;
+    prev[v] = u;
+    heap.push_back({dist[v], v});
+    push_heap(heap.begin(), heap.end(), greater<>());
+    propagate();
+}
+
+// Some u -> v edge got dearer or went away
+void DynamicShortestPaths::raised(int u, int v) {
+    if (prev[v] != u) {
+        return;
+    }
+    for (const Arc& arc : in[v]) {
+        int distance;
+        if (arc.vertex == u && add_path_length(dist[u], arc.weight, distance) && distance == dist[v]) {
+            return;   // A parallel edge still carries the same distance
+        }
+    }
+
+    // v's subtree: the vertices whose tree path runs through the old edge
+    vector<int> subtree = {v};
+    prev[v] = -1;
+    dist[v] = INF;
+    for (size_t i = 0; i < subtree.size(); ++i) {
+        for (const Arc& arc : out[subtree[i]]) {
+            if (prev[arc.vertex] == subtree[i]) {
+                prev[arc.vertex] = -1;
+                dist[arc.vertex] = INF;
+                subtree.push_back(arc.vertex);
+            }
+        }
+    }
+
+    // Every distance outside the subtree is still exact, so each subtree vertex starts
+    // from its best edge in from a vertex that has a distance; the ones from subtree
+    // vertices seeded earlier are only upper bounds, which propagate() then lowers
+    for (int x : subtree) {
+        for (const Arc& arc : in[x]) {
+            int from = arc.vertex, distance;
+            if (dist[from] != INF && relax(from, x, arc.weight, distance) && distance < dist[x]) {
+                dist[x] = distance;
+                prev[x] = from;
+            }
+        }
+        if (dist[x] != INF) {
+            heap.push_back({dist[x], x});
+        }
+    }
+    make_heap(heap.begin(), heap.end(), greater<>());
+    propagate();
+}
+
+// Dijkstra from the vertices in heap, settling only those whose distance went down
+void DynamicShortestPaths::propagate() {
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), greater<>());
+        auto [distance, u] = heap.back();
+        heap.pop_back();
+        if (distance > dist[u]) {
+            continue;
+        }
+        ++settled;
+        for (const Arc& arc : out[u]) {
+            int length;
+            if (relax(u, arc.vertex, arc.weight, length) && length < dist[arc.vertex]) {
+                dist[arc.vertex] = length;
+                prev[arc.vertex] = u;
+                heap.push_back({dist[arc.vertex], arc.vertex});
+                push_heap(heap.begin(), heap.end(), greater<>());
+            }
+        }
+    }
+}
+
+// dist[u] + weight in distance, or false (noting v) when the sum is too long for int
+bool DynamicShortestPaths::relax(int u, int v, int weight, int& distance) {
+    if (add_path_length(dist[u], weight, distance)) {
+        return true;
+    }
+    overflowed.push_back(v);
+    return false;
+}
+
+// As in dijkstra_shortest_path, a head the update left unreached behind an overflowing
+// edge has a distance int can't hold
+void DynamicShortestPaths::check_overflow() {
+    vector<int> heads;
+    heads.swap(overflowed);
+    for (int v : heads) {
+        if (dist[v] == INF) {
+            throw runtime_error("Distance to vertex " + to_string(v) + " overflows the 32-bit edge weight type");
+        }
+    }
+}
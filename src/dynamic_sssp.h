@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include "dijkstras.h"
+
+using namespace std;
+
+// Single-source shortest paths that stay current while edges change. The graph is held
+// as editable in- and out-edge lists next to the distances and previous tree, and each
+// update re-settles only the vertices whose distance can change:
+//
+//   - an edge that gets cheaper (or is new) lowers distances outward from its head
+//     with a Dijkstra seeded at that one vertex;
+//   - an edge that gets dearer (or goes away) matters only if it was the tree edge
+//     into its head. That head's subtree of the previous tree is cut loose, every
+//     vertex in it takes its best distance through an edge from outside the subtree,
+//     and a Dijkstra over the subtree settles the rest.
+//
+// Distances always equal a full dijkstra_shortest_path on graph(). previous is a
+// valid shortest-path tree, though where paths tie it can pick other parents than a
+// full run. Needs non-negative weights. Like the full run, an update throws
+// runtime_error if it leaves a reachable vertex with a distance too long for int; the
+// edge change itself has been made by then.
+class DynamicShortestPaths {
+public:
+    DynamicShortestPaths(const CSRGraph& G, int source);
+    DynamicShortestPaths(const Graph& G, int source) : DynamicShortestPaths(CSRGraph(G), source) {}
+
+    int source() const { return root; }
+    int numVertices() const { return out.size(); }
+    const vector<int>& distances() const { return dist; }
+    const vector<int>& previous() const { return prev; }
+
+    // Adds an edge u -> v, alongside any existing u -> v edges
+    void insert_edge(int u, int v, int weight);
+    // Removes every u -> v edge; does nothing if there is none
+    void remove_edge(int u, int v);
+    // Replaces every u -> v edge with a single edge of this weight, inserting it if needed
+    void set_weight(int u, int v, int weight);
+
+    // Vertices whose distance the last update settled again
+    int last_settled() const { return settled; }
+
+    // The current graph, with each vertex's edges in the order they were added
+    CSRGraph graph() const;
+
+private:
+    struct Arc {
+        int vertex;
+        int weight;
+    };
+
+    void check(int u, int v, int weight) const;
+    void erase(vector<Arc>& arcs, int vertex);
+    void lowered(int u, int v, int weight);
+    void raised(int u, int v);
+    void propagate();
+    bool relax(int u, int v, int weight, int& distance);
+    void check_overflow();
+
+    int root;
+    vector<vector<Arc>> out;
+    vector<vector<Arc>> in;
+    vector<int> dist;
+    vector<int> prev;
+    vector<pair<int, int>> heap;   // (distance, vertex) min-heap for propagate()
+    vector<int> overflowed;        // Heads of relaxations this update skipped as too long
+    int settled = 0;
+};
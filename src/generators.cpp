@@ -0,0 +1,123 @@
+#include "generators.h"
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+
+CSRGraph random_graph(int numVertices, int degree, unsigned seed, int maxWeight) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> vertex(0, numVertices - 1), weight(1, maxWeight);
+    vector<Edge> edges;
+    edges.reserve(size_t(numVertices) * degree);
+    for (int u = 0; u < numVertices; ++u) {
+        for (int i = 0; i < degree; ++i) {
+            edges.emplace_back(u, vertex(rng), weight(rng));
+        }
+    }
+    return CSRGraph(numVertices, edges);
+}
+
+CSRGraph grid_graph(int rows, int cols, unsigned seed, int maxWeight) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    vector<Edge> edges;
+    edges.reserve(size_t(rows) * cols * 4);
+    auto link = [&](int u, int v) {
+        int w = weight(rng);
+        edges.emplace_back(u, v, w);
+        edges.emplace_back(v, u, w);
+    };
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int u = r * cols + c;
+            if (c + 1 < cols) link(u, u + 1);
+            if (r + 1 < rows) link(u, u + cols);
+        }
+    }
+    return CSRGraph(rows * cols, edges);
+}
+
+CSRGraph power_law_graph(int numVertices, int degree, unsigned seed, int maxWeight) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    vector<Edge> edges;
+    // Every edge end is listed once, so a uniform pick from it is a degree-weighted pick
+    vector<int> ends;
+    auto link = [&](int u, int v) {
+        int w = weight(rng);
+        edges.emplace_back(u, v, w);
+        edges.emplace_back(v, u, w);
+        ends.push_back(u);
+        ends.push_back(v);
+    };
+    int core = min(numVertices, degree + 1);
+    for (int u = 0; u < core; ++u) {
+        for (int v = u + 1; v < core; ++v) link(u, v);
+    }
+    vector<int> picked;
+    for (int v = core; v < numVertices; ++v) {
+        picked.clear();
+        while (int(picked.size()) < degree) {
+            int u = ends[uniform_int_distribution<size_t>(0, ends.size() - 1)(rng)];
+            if (find(picked.begin(), picked.end(), u) == picked.end()) picked.push_back(u);
+        }
+        for (int u : picked) link(u, v);
+    }
+    return CSRGraph(numVertices, edges);
+}
+
+vector<string> synthetic_words(int count, unsigned seed, int maxLength) {
+    // The root can't be edited below two letters, and the list can't outgrow the
+    // 26^2 + ... + 26^maxLength words of those lengths
+    if (maxLength < 2) {
+        throw runtime_error("Synthetic words need a maximum length of at least 2, not " + to_string(maxLength));
+    }
+    long long available = 0;
+    for (int length = 2; length <= maxLength && available < count; ++length) {
+        long long words = 1;
+        for (int i = 0; i < length && words < count; ++i) words *= 26;
+        available += words;
+    }
+    if (count > available) {
+        throw runtime_error("Can't make " + to_string(count) + " distinct words of 2.." + to_string(maxLength)
+                            + " letters; there are only " + to_string(available));
+    }
+    mt19937 rng(seed);
+    uniform_int_distribution<int> letter('a', 'z');
+    auto random_word = [&](int length) {
+        string word;
+        for (int i = 0; i < length; ++i) word += char(letter(rng));
+        return word;
+    };
+    vector<string> words = {random_word(min(4, maxLength))};
+    unordered_set<string> seen(words.begin(), words.end());
+    while (int(words.size()) < count) {
+        string word = words[uniform_int_distribution<size_t>(0, words.size() - 1)(rng)];
+        int at = uniform_int_distribution<int>(0, word.size())(rng);
+        int edit = uniform_int_distribution<int>(0, 4)(rng);
+        if (edit <= 2 && at < int(word.size())) {
+            word[at] = char(letter(rng));
+        } else if (edit == 3 && int(word.size()) < maxLength) {
+            word.insert(word.begin() + at, char(letter(rng)));
+        } else if (edit == 4 && word.size() > 2 && at < int(word.size())) {
+            word.erase(word.begin() + at);
+        } else {
+            continue;
+        }
+        if (seen.insert(word).second) words.push_back(word);
+    }
+    return words;
+}
+
+void write_words(const vector<string>& words, const string& filename) {
+    ofstream out(filename, ios::trunc);
+    if (!out) {
+        throw runtime_error("Can't open word file " + filename);
+    }
+    for (const string& word : words) {
+        out << word << '\n';
+    }
+    out.close();
+    if (!out) {
+        throw runtime_error("Can't write word file " + filename);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "dijkstras.h"
+
+using namespace std;
+
+// Synthetic inputs for benchmarks and tests. Every generator is deterministic for a
+// given seed; graphs are returned as CSRGraph and can be saved with write_text_graph
+// (or write_binary_graph), word lists with write_words.
+
+// Uniform random graph: `degree` out-edges per vertex to uniformly chosen heads,
+// weights uniform in 1..maxWeight
+CSRGraph random_graph(int numVertices, int degree, unsigned seed, int maxWeight = 100);
+
+// rows x cols grid with edges both ways between horizontal and vertical neighbors,
+// each pair sharing one weight from 1..maxWeight. Long shortest paths, like road maps.
+CSRGraph grid_graph(int rows, int cols, unsigned seed, int maxWeight = 100);
+
+// Preferential attachment (Barabasi-Albert): each vertex after the first `degree` + 1
+// links both ways to `degree` earlier vertices picked in proportion to their degree,
+// so a few hubs collect most of the edges. Weights 1..maxWeight.
+CSRGraph power_law_graph(int numVertices, int degree, unsigned seed, int maxWeight = 100);
+
+// `count` distinct lowercase words, grown from one random root by applying a random
+// substitution, insertion or deletion to a word already in the list. Every word is
+// therefore reachable from every other one by a word ladder, as in a real dictionary
+// only denser. Lengths stay within 2..maxLength; throws runtime_error if maxLength < 2
+// or there are fewer than `count` words of those lengths.
+vector<string> synthetic_words(int count, unsigned seed, int maxLength = 10);
+
+// One word per line, in the order given; throws runtime_error on failure
+void write_words(const vector<string>& words, const string& filename);
@@ -1,12 +1,93 @@
 #include "ladder.h"
+#include "ladder_cache.h"
+#include "thread_pool.h"
 #include <unordered_map>
-#include <unordered_set>
 #include <algorithm>
+#include <cstdint>
+#include <atomic>
+#include <tuple>
+#include <limits>
 
 void error(string word1, string word2, string msg) {
     cout << "Cannot create word ladder from '" << word1 << "' to '" << word2 << "': " << msg << endl;
 }
 
+// Bit-parallel edit distance (Myers 1999, in Hyyro's formulation for global distance).
+// A DP column is kept as vertical deltas: bit i of pv/mv is set when D[i+1][j] - D[i][j]
+// is +1/-1, and only the bottom cell D[m][j] is tracked as an integer. Each text character
+// then costs a handful of word operations instead of m cell updates. Since the bottom cell
+// drops by at most one per remaining column, the scan stops as soon as it cannot get back
+// within d. Every column is computed in full rather than just its 2d+1 diagonal band:
+// up to 64 rows the whole column is one word, so a band would save nothing.
+static bool myers_within(const string& pattern, const string& text, int d) {
+    int m = pattern.length();
+    int n = text.length();
+    uint64_t peq[256] = {};
+    for (int i = 0; i < m; i++) {
+        peq[static_cast<unsigned char>(tolower(pattern[i]))] |= uint64_t(1) << i;
+    }
+
+    uint64_t pv = ~uint64_t(0), mv = 0;
+    uint64_t last = uint64_t(1) << (m - 1);
+    int score = m;
+    for (int j = 0; j < n; j++) {
+        uint64_t eq = peq[static_cast<unsigned char>(tolower(text[j]))];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) score++;
+        else if (mh & last) score--;
+        // The top row D[0][j] = j always steps by +1
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if (score - (n - 1 - j) > d) return false;
+    }
+    return score <= d;
+}
+
+// Multi-word variant of myers_within for patterns longer than 64 characters: the column
+// is split into 64-bit blocks and each block hands its horizontal delta to the next.
+static bool myers_blocks_within(const string& pattern, const string& text, int d) {
+    int m = pattern.length();
+    int n = text.length();
+    int blocks = (m + 63) / 64;
+    vector<uint64_t> peq(256 * blocks, 0);
+    for (int i = 0; i < m; i++) {
+        peq[static_cast<unsigned char>(tolower(pattern[i])) * blocks + i / 64] |= uint64_t(1) << (i % 64);
+    }
+
+    vector<uint64_t> pv(blocks, ~uint64_t(0)), mv(blocks, 0);
+    uint64_t last = uint64_t(1) << ((m - 1) % 64);
+    int score = m;
+    for (int j = 0; j < n; j++) {
+        const uint64_t* eqs = &peq[static_cast<unsigned char>(tolower(text[j])) * blocks];
+        int carry = 1;
+        for (int b = 0; b < blocks; b++) {
+            uint64_t eq = eqs[b];
+            uint64_t xv = eq | mv[b];
+            if (carry < 0) eq |= 1;
+            uint64_t xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            uint64_t ph = mv[b] | ~(xh | pv[b]);
+            uint64_t mh = pv[b] & xh;
+            uint64_t high = (b == blocks - 1) ? last : uint64_t(1) << 63;
+            int out = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+            ph <<= 1;
+            mh <<= 1;
+            if (carry > 0) ph |= 1;
+            else if (carry < 0) mh |= 1;
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+            carry = out;
+        }
+        score += carry;
+        if (score - (n - 1 - j) > d) return false;
+    }
+    return score <= d;
+}
+
 bool edit_distance_within(const std::string& str1, const std::string& str2, int d) {
     int len1 = str1.length();
     int len2 = str2.length();
@@ -53,137 +134,441 @@ bool edit_distance_within(const std::string& str1, const std::string& str2, int
         return false;
     }
     
-
-    // Create a dynamic programming matrix
-    vector<int> prev(len2 + 1), curr(len2 + 1);
-    for (int j = 0; j <= len2; j++) prev[j] = j;
-
-    for (int i = 1; i <= len1; i++) {
-        curr[0] = i;
-        for (int j = 1; j <= len2; j++) {
-            if (tolower(str1[i-1]) == tolower(str2[j-1])) {
-                curr[j] = prev[j-1];
-            } else {
-                curr[j] = 1 + min(prev[j-1], min(prev[j], curr[j-1]));
-            }
-        }
-        prev = curr;
+    // Distance is symmetric, so use the shorter string as the bit-parallel pattern
+    const string& pattern = (len1 <= len2) ? str1 : str2;
+    const string& text = (len1 <= len2) ? str2 : str1;
+    if (pattern.length() <= 64) {
+        return myers_within(pattern, text, d);
     }
-    return prev[len2] <= d;
+    return myers_blocks_within(pattern, text, d);
 }
 
+// is_adjacent calls made on this thread, for LadderStats
+static thread_local size_t adjacency_checks = 0;
+
 // Check if two words are adjacent (edit distance = 1)
 bool is_adjacent(const string& word1, const string& word2) {
+    if constexpr (STATS_ENABLED) adjacency_checks++;
     return edit_distance_within(word1, word2, 1);
 }
 
-unordered_map<int, vector<string>> organize_by_length(const set<string>& word_list) {
-    unordered_map<int, vector<string>> length_map;
-    for (const string& word : word_list) {
-        length_map[word.length()].push_back(word);
+static string to_lower(const string& word) {
+    string lower = word;
+    for (char& c : lower) c = tolower(c);
+    return lower;
+}
+
+LadderIndex::LadderIndex(const set<string>& word_list) : LadderIndex(Dictionary(word_list)) {}
+
+LadderIndex::LadderIndex(Dictionary dictionary) : words(move(dictionary)) {
+    string key;
+    for (int id = 0; id < size(); id++) {
+        string_view word = words.word(id);
+        int len = word.length();
+
+        // Wildcard patterns link words of the same length that differ in one position
+        for (int i = 0; i < len; i++) {
+            key = word;
+            key[i] = '*';
+            wildcard_buckets[key].push_back(id);
+        }
+
+        // Deletion patterns link a word to the words one letter shorter than it;
+        // repeated letters yield the same pattern twice, so register it only once
+        for (int i = 0; i < len; i++) {
+            if (i > 0 && word[i] == word[i - 1]) continue;
+            key = word;
+            key.erase(i, 1);
+            vector<int>& bucket = deletion_buckets[key];
+            if (bucket.empty() || bucket.back() != id) {
+                bucket.push_back(id);
+            }
+        }
     }
-    return length_map;
 }
 
-vector<string> find_potential_neighbors(const string& word, 
-                                       const unordered_map<int, vector<string>>& words_by_length) {
-    vector<string> candidates;
+LadderIndex::LadderIndex(Dictionary dictionary, shared_ptr<const LadderCache> cache)
+    : words(move(dictionary)), cache(move(cache)) {}
+
+void LadderIndex::neighbors(int id, vector<int>& out) const {
+    if (cache) {
+        span<const unsigned> adjacent = cache->neighbors(id);
+        out.insert(out.end(), adjacent.begin(), adjacent.end());
+    } else {
+        neighbors(word(id), out);
+    }
+}
+
+// Without pattern buckets, a word outside the dictionary is compared against every
+// word within one letter of its length. Only a query's begin word ever lands here.
+void LadderIndex::scan_neighbors(string_view word, vector<int>& out) const {
+    string query(word);
     int len = word.length();
-    
-    // For each possible length (same, one bit shorter, one bit longer)
     for (int l : {len, len - 1, len + 1}) {
-        if (l < 1 || words_by_length.find(l) == words_by_length.end()) continue;
-        
-        if (l == len) {
-            for (const string& candidate : words_by_length.at(l)) {
-                if (candidate == word) continue;
-                
-                int diff = 0;
-                for (int i = 0; i < len && diff <= 1; i++) {
-                    if (tolower(word[i]) != tolower(candidate[i])) diff++;
+        for (int id : words.words_of_length(l)) {
+            if (words.word(id) != word && is_adjacent(query, string(words.word(id)))) {
+                out.push_back(id);
+            }
+        }
+    }
+}
+
+void LadderIndex::neighbors(string_view word, vector<int>& out) const {
+    if (cache) {
+        int id = find(word);
+        if (id == -1) scan_neighbors(word, out);
+        else neighbors(id, out);
+        return;
+    }
+
+    int len = word.length();
+    int self = find(word);
+    string key;
+
+    // Same length: words sharing one of our wildcard patterns
+    size_t block = out.size();
+    for (int i = 0; i < len; i++) {
+        key = word;
+        key[i] = '*';
+        auto it = wildcard_buckets.find(key);
+        if (it == wildcard_buckets.end()) continue;
+        for (int id : it->second) {
+            if (id != self) out.push_back(id);
+        }
+    }
+    sort(out.begin() + block, out.end());
+
+    // One letter shorter: our deletions that are themselves dictionary words
+    block = out.size();
+    for (int i = 0; i < len; i++) {
+        if (i > 0 && word[i] == word[i - 1]) continue;
+        key = word;
+        key.erase(i, 1);
+        int id = find(key);
+        if (id != -1) out.push_back(id);
+    }
+    sort(out.begin() + block, out.end());
+    out.erase(unique(out.begin() + block, out.end()), out.end());
+
+    // One letter longer: words that have us as one of their deletion patterns
+    key = word;
+    auto it = deletion_buckets.find(key);
+    if (it != deletion_buckets.end()) {
+        out.insert(out.end(), it->second.begin(), it->second.end());
+    }
+}
+
+namespace {
+
+// Word ids of a single ladder query: the dictionary ids, plus the extra id index.size()
+// for a begin word outside the dictionary, which only the begin side can ever reach.
+// Searches record a parent id per visited word (-2 unvisited, -1 root) and build the
+// ladder strings only once the end word is found.
+struct LadderQuery {
+    const LadderIndex& index;
+    string_view begin_word;
+    int begin_id;
+    int end_id;
+
+    LadderQuery(const LadderIndex& index, const string& begin_lower, const string& end_lower)
+        : index(index), begin_word(begin_lower), begin_id(index.find(begin_lower)), end_id(index.find(end_lower)) {
+        if (begin_id == -1) begin_id = index.size();
+    }
+
+    int size() const { return index.size() + 1; }
+    string_view word(int id) const { return id == index.size() ? begin_word : index.word(id); }
+
+    void neighbors(int id, vector<int>& out) const {
+        out.clear();
+        if (id == index.size()) index.neighbors(begin_word, out);
+        else index.neighbors(id, out);
+    }
+
+    // The same, counting the expansion into stats
+    void expand(int id, vector<int>& out, LadderStats& stats) const {
+        neighbors(id, out);
+        stats.nodes_expanded++;
+        if constexpr (STATS_ENABLED) stats.candidates += out.size();
+    }
+
+    // Ladder from the root of the parent tree down to id
+    template <class ParentArray>
+    vector<string> trace(const ParentArray& parent, int id) const {
+        vector<string> ladder;
+        for (; id != -1; id = parent[id]) ladder.emplace_back(word(id));
+        reverse(ladder.begin(), ladder.end());
+        return ladder;
+    }
+};
+
+// Records that the search's open queue or frontiers now hold this many bytes
+void note_queue_bytes(LadderStats& stats, size_t bytes) {
+    if constexpr (STATS_ENABLED) stats.peak_queue_bytes = max(stats.peak_queue_bytes, bytes);
+}
+
+vector<string> bfs_ladder(const LadderQuery& query, LadderStats& stats) {
+    vector<int> parent(query.size(), -2);
+    parent[query.begin_id] = -1;
+
+    // Every id is enqueued at most once, so a flat array with a read cursor is the queue
+    vector<int> queue;
+    queue.reserve(query.size());
+    queue.push_back(query.begin_id);
+
+    vector<int> neighbors;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int u = queue[head];
+        // Neighbors come back same length first, then shorter, then longer
+        query.expand(u, neighbors, stats);
+        for (int v : neighbors) {
+            if (parent[v] != -2) continue;
+            parent[v] = u;
+            if (v == query.end_id) return query.trace(parent, v);
+            queue.push_back(v);
+        }
+        note_queue_bytes(stats, (queue.size() - head - 1) * sizeof(int));
+    }
+    return {};
+}
+
+vector<string> bidirectional_ladder(const LadderQuery& query, LadderStats& stats) {
+    vector<int> parent[2] = {vector<int>(query.size(), -2), vector<int>(query.size(), -2)};
+    vector<int> frontier[2] = {{query.begin_id}, {query.end_id}};
+    parent[0][query.begin_id] = -1;
+    parent[1][query.end_id] = -1;
+
+    vector<int> next, neighbors;
+    while (!frontier[0].empty() && !frontier[1].empty()) {
+        int side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+        next.clear();
+        for (int u : frontier[side]) {
+            query.expand(u, neighbors, stats);
+            for (int v : neighbors) {
+                if (parent[side][v] != -2) continue;
+                parent[side][v] = u;
+
+                // The first meeting is already shortest: any node the other side reached
+                // at a shallower depth would have been met while expanding that depth
+                if (parent[1 - side][v] != -2) {
+                    vector<string> ladder = query.trace(parent[0], v);
+                    for (int id = parent[1][v]; id != -1; id = parent[1][id]) ladder.emplace_back(query.word(id));
+                    return ladder;
                 }
-                
-                if (diff == 1) {
-                    candidates.push_back(candidate);
+                next.push_back(v);
+            }
+        }
+        note_queue_bytes(stats, (frontier[0].size() + frontier[1].size() + next.size()) * sizeof(int));
+        swap(frontier[side], next);
+    }
+    return {};
+}
+
+// Level-synchronous BFS: each level's frontier is cut into chunks that worker threads
+// expand into private next-frontier lists, claiming unvisited words with a CAS on the
+// shared parent array. Every word of a level is settled before the next level starts,
+// so the first level that reaches the end word gives a shortest ladder, although
+// which of several shortest ladders comes back depends on thread timing.
+vector<string> parallel_ladder(const LadderQuery& query, const ParallelLadderOptions& options, LadderStats& stats) {
+    vector<atomic<int>> parent(query.size());
+    for (atomic<int>& p : parent) p.store(-2, memory_order_relaxed);
+    parent[query.begin_id].store(-1, memory_order_relaxed);
+
+    // Returns the number of candidates generated, for stats
+    auto expand = [&](span<const int> chunk, vector<int>& next) {
+        vector<int> neighbors;
+        size_t candidates = 0;
+        for (int u : chunk) {
+            query.neighbors(u, neighbors);
+            candidates += neighbors.size();
+            for (int v : neighbors) {
+                int unvisited = -2;
+                if (parent[v].load(memory_order_relaxed) == -2
+                    && parent[v].compare_exchange_strong(unvisited, u, memory_order_relaxed)) {
+                    next.push_back(v);
                 }
             }
         }
-        // For the case where the length difference is 1, add all candidate words and perform precise checks later
-        else {
-            for (const string& candidate : words_by_length.at(l)) {
-                candidates.push_back(candidate);
+        return candidates;
+    };
+
+    unique_ptr<ThreadPool> pool;
+    vector<int> frontier = {query.begin_id};
+    vector<int> next;
+    while (!frontier.empty()) {
+        next.clear();
+        stats.nodes_expanded += frontier.size();
+        size_t candidates = 0;
+        if (frontier.size() < max<size_t>(options.min_parallel_frontier, 2)) {
+            candidates = expand(frontier, next);
+        } else {
+            if (!pool) pool = make_unique<ThreadPool>(options.threads);
+            // A few chunks per thread evens out words with very different degrees
+            size_t chunks = min<size_t>(frontier.size(), pool->size() * 4);
+            vector<vector<int>> partial(chunks);
+            vector<future<size_t>> done;
+            for (size_t c = 0; c < chunks; c++) {
+                size_t first = frontier.size() * c / chunks;
+                size_t last = frontier.size() * (c + 1) / chunks;
+                span<const int> chunk(frontier.data() + first, last - first);
+                done.push_back(pool->submit([&expand, chunk, &out = partial[c]] { return expand(chunk, out); }));
             }
+            for (future<size_t>& chunk_done : done) candidates += chunk_done.get();
+            for (const vector<int>& part : partial) next.insert(next.end(), part.begin(), part.end());
         }
+        if constexpr (STATS_ENABLED) stats.candidates += candidates;
+        note_queue_bytes(stats, (frontier.size() + next.size()) * sizeof(int));
+        if (parent[query.end_id].load() != -2) return query.trace(parent, query.end_id);
+        swap(frontier, next);
     }
-    
-    return candidates;
+    return {};
 }
 
+// Lower bound on the edit distance between two words from their letter counts: an edit
+// removes at most one letter and adds at most one, so it shrinks either surplus by at
+// most one. The bound also changes by at most one per ladder step, which makes it a
+// consistent A* heuristic.
+class LetterCountBound {
+public:
+    explicit LetterCountBound(string_view target) {
+        for (char c : target) counts[static_cast<unsigned char>(c)]++;
+    }
+
+    int operator()(string_view word) const {
+        int delta[256];
+        copy(begin(counts), end(counts), delta);
+        int surplus = 0;
+        for (char c : word) {
+            if (--delta[static_cast<unsigned char>(c)] < 0) surplus++;
+        }
+        int missing = 0;
+        for (int d : delta) {
+            if (d > 0) missing += d;
+        }
+        return max(surplus, missing);
+    }
+
+private:
+    int counts[256] = {};
+};
+
+// A* over unit-cost ladder steps. Ties on f = g + h go to the deeper word, which heads
+// straight for the end word once the bound becomes tight. With a consistent bound a
+// word's ladder length is final when it is popped, so the end word pops at its BFS depth.
+vector<string> astar_ladder(const LadderQuery& query, LadderStats& stats) {
+    LetterCountBound bound(query.word(query.end_id));
+    vector<int> parent(query.size(), -2);
+    vector<int> depth(query.size(), numeric_limits<int>::max());
+    vector<bool> closed(query.size(), false);
+    parent[query.begin_id] = -1;
+    depth[query.begin_id] = 0;
+
+    // (f, -depth, id), smallest first
+    using Entry = tuple<int, int, int>;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+    open.emplace(bound(query.word(query.begin_id)), 0, query.begin_id);
+
+    vector<int> neighbors;
+    while (!open.empty()) {
+        int u = get<2>(open.top());
+        open.pop();
+        if (closed[u]) continue;
+        if (u == query.end_id) return query.trace(parent, u);
+        closed[u] = true;
+
+        query.expand(u, neighbors, stats);
+        for (int v : neighbors) {
+            if (closed[v] || depth[u] + 1 >= depth[v]) continue;
+            depth[v] = depth[u] + 1;
+            parent[v] = u;
+            open.emplace(depth[v] + bound(query.word(v)), -depth[v], v);
+        }
+        note_queue_bytes(stats, open.size() * sizeof(Entry));
+    }
+    return {};
+}
+
+} // namespace
+
 vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list) {
+    return generate_word_ladder(begin_word, end_word, LadderIndex(word_list));
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list,
+                                    LadderSearch search) {
+    return generate_word_ladder(begin_word, end_word, LadderIndex(word_list), search);
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const Dictionary& dictionary,
+                                    LadderSearch search) {
+    return generate_word_ladder(begin_word, end_word, LadderIndex(dictionary), search);
+}
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const LadderIndex& index,
+                                    LadderSearch search) {
+    LadderResult result = find_word_ladder(begin_word, end_word, index, search);
+    if (!result.error.empty()) {
+        error(begin_word, end_word, result.error);
+    }
+    return result.ladder;
+}
+
+LadderResult find_word_ladder(const string& begin_word, const string& end_word, const LadderIndex& index,
+                              LadderSearch search, const ParallelLadderOptions& options) {
     // Convert input words to lowercase
-    string begin_lower = begin_word;
-    string end_lower = end_word;
-    for (char& c : begin_lower) c = tolower(c);
-    for (char& c : end_lower) c = tolower(c);
+    string begin_lower = to_lower(begin_word);
+    string end_lower = to_lower(end_word);
     
     if (begin_lower == end_lower) {
-        error(begin_word, end_word, "Start and end words are the same");
-        return {};
+        return {{}, "Start and end words are the same", {}};
     }
     
     // Check if end word is in the dictionary
-    if (word_list.find(end_lower) == word_list.end()) {
-        error(begin_word, end_word, "End word not in dictionary");
-        return {};
+    if (index.find(end_lower) == -1) {
+        return {{}, "End word not in dictionary", {}};
     }
     
-    // Precompute words grouped by length
-    unordered_map<int, vector<string>> words_by_length = organize_by_length(word_list);
-    
-    // Initialize queue for BFS
-    queue<vector<string>> ladder_queue;
-    ladder_queue.push({begin_lower});
-    
-    unordered_set<string> visited;
-    visited.insert(begin_lower);
-    
-    while (!ladder_queue.empty()) {
-        vector<string> current_ladder = ladder_queue.front();
-        ladder_queue.pop();
-        
-        string last_word = current_ladder.back();
-        
-        // Use pre-filtering to reduce the number of words you need to check
-        vector<string> potential_neighbors = find_potential_neighbors(last_word, words_by_length);
-        
-        // Check words of same length first, then shorter, then longer
-        int last_len = last_word.length();
-        
-        for (int len : {last_len, last_len - 1, last_len + 1}) {
-            if (len < 1) continue;
-            
-            for (const string& word : potential_neighbors) {
-                if (word.length() != len) continue;
-                if (visited.find(word) != visited.end()) continue;
-                
-                if (is_adjacent(last_word, word)) {
-                    visited.insert(word);
-                    
-                    vector<string> new_ladder = current_ladder;
-                    new_ladder.push_back(word);
-                    
-                    if (word == end_lower) {
-                        return new_ladder;
-                    }
-                    
-                    ladder_queue.push(new_ladder);
-                }
-            }
+    LadderQuery query(index, begin_lower, end_lower);
+    LadderResult result;
+    // Only a begin word outside a cached index needs is_adjacent, and the begin word is
+    // always expanded on this thread
+    size_t checks_before = adjacency_checks;
+    switch (search) {
+        case LadderSearch::BFS: result.ladder = bfs_ladder(query, result.stats); break;
+        case LadderSearch::Bidirectional: result.ladder = bidirectional_ladder(query, result.stats); break;
+        case LadderSearch::Parallel: result.ladder = parallel_ladder(query, options, result.stats); break;
+        case LadderSearch::AStar: result.ladder = astar_ladder(query, result.stats); break;
+    }
+    result.stats.is_adjacent_calls = adjacency_checks - checks_before;
+    if (result.ladder.empty()) {
+        result.error = "No word ladder exists";
+    }
+    return result;
+}
+
+string to_json(const LadderStats& stats) {
+    return "{\"nodes_expanded\": " + to_string(stats.nodes_expanded) + ", \"candidates\": "
+           + to_string(stats.candidates) + ", \"is_adjacent_calls\": " + to_string(stats.is_adjacent_calls)
+           + ", \"peak_queue_bytes\": " + to_string(stats.peak_queue_bytes) + "}";
+}
+
+vector<LadderResult> generate_word_ladders(const vector<pair<string, string>>& queries, const LadderIndex& index,
+                                           unsigned threads, LadderSearch search) {
+    vector<future<LadderResult>> pending;
+    pending.reserve(queries.size());
+    {
+        ThreadPool pool(threads);
+        for (const pair<string, string>& query : queries) {
+            pending.push_back(pool.submit([&query, &index, search] {
+                return find_word_ladder(query.first, query.second, index, search);
+            }));
         }
     }
-    
-    error(begin_word, end_word, "No word ladder exists");
-    return {};
+    vector<LadderResult> results;
+    results.reserve(pending.size());
+    for (future<LadderResult>& result : pending) {
+        results.push_back(result.get());
+    }
+    return results;
 }
 
 void load_words(set<string>& word_list, const string& file_name) {
@@ -222,13 +607,14 @@ void print_word_ladder(const vector<string>& ladder) {
 
 #define my_assert(e) {cout << #e << ((e) ? " passed": " failed") << endl;}
 void verify_word_ladder() {
-    set<string> word_list;
-    load_words(word_list, "words.txt");
+    Dictionary dictionary;
+    load_words(dictionary, "words.txt");
+    LadderIndex index(move(dictionary));
     
-    my_assert(generate_word_ladder("cat", "dog", word_list).size() == 4);
-    my_assert(generate_word_ladder("marty", "curls", word_list).size() == 6);
-    my_assert(generate_word_ladder("code", "data", word_list).size() == 6);
-    my_assert(generate_word_ladder("work", "play", word_list).size() == 6);
-    my_assert(generate_word_ladder("sleep", "awake", word_list).size() == 8);
-    my_assert(generate_word_ladder("car", "cheat", word_list).size() == 4);
+    my_assert(generate_word_ladder("cat", "dog", index).size() == 4);
+    my_assert(generate_word_ladder("marty", "curls", index).size() == 6);
+    my_assert(generate_word_ladder("code", "data", index).size() == 6);
+    my_assert(generate_word_ladder("work", "play", index).size() == 6);
+    my_assert(generate_word_ladder("sleep", "awake", index).size() == 8);
+    my_assert(generate_word_ladder("car", "cheat", index).size() == 4);
 }
@@ -6,13 +6,102 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <unordered_map>
+#include <memory>
+#include "dictionary.h"
+#include "stats.h"
 
 using namespace std;
 
+// Neighbor index over a word list, built once and shared across many ladder queries.
+// Every word is registered under its wildcard patterns ("c*t" for "cat") and its
+// deletion patterns ("ct", "at", "ca"), so the words one edit away from any string
+// are found with O(word length) hash probes instead of a scan over the dictionary.
+// Word ids are the ids of the underlying Dictionary.
+// When constructed over a LadderCache (see ladder_cache.h), dictionary words take their
+// neighbors from the precomputed graph and no pattern buckets are built at all.
+class LadderCache;
+class LadderIndex {
+public:
+    explicit LadderIndex(const set<string>& word_list);
+    explicit LadderIndex(Dictionary dictionary);
+    LadderIndex(Dictionary dictionary, shared_ptr<const LadderCache> cache);
+
+    const Dictionary& dictionary() const { return words; }
+    int size() const { return words.size(); }
+    string_view word(int id) const { return words.word(id); }
+
+    // Returns the id of a lowercase word, or -1 if it is not in the dictionary
+    int find(string_view word) const { return words.find(word); }
+
+    // Appends the ids of all dictionary words at edit distance exactly 1 from the
+    // lowercase word: same length first, then shorter, then longer, each in dictionary order
+    void neighbors(string_view word, vector<int>& out) const;
+    void neighbors(int id, vector<int>& out) const;
+
+private:
+    void scan_neighbors(string_view word, vector<int>& out) const;
+
+    Dictionary words;
+    shared_ptr<const LadderCache> cache;
+    unordered_map<string, vector<int>> wildcard_buckets;
+    unordered_map<string, vector<int>> deletion_buckets;
+};
+
+// Search strategy used by generate_word_ladder; every strategy returns a ladder of the same (shortest) length
+enum class LadderSearch {
+    BFS,            // Breadth-first search outward from begin_word
+    Bidirectional,  // Breadth-first from both ends, always expanding the smaller frontier
+    Parallel,       // Level-synchronous breadth-first search with each level split across threads
+    AStar           // Best-first search guided by a letter-count lower bound on the edits left
+};
+
+// Tuning for LadderSearch::Parallel
+struct ParallelLadderOptions {
+    unsigned threads = 0;               // 0 means one per hardware thread
+    size_t min_parallel_frontier = 512; // Smaller levels are expanded serially on the calling thread
+};
+
+// Work done by one ladder search. nodes_expanded is always counted; the rest only when
+// STATS_ENABLED (see stats.h).
+struct LadderStats {
+    size_t nodes_expanded = 0;     // Words whose neighbors were generated
+    size_t candidates = 0;         // Neighbors generated for them, before the visited check
+    size_t is_adjacent_calls = 0;  // Edit-distance checks; only a begin word outside a cached index needs them
+    size_t peak_queue_bytes = 0;   // Most bytes the search's queue or frontiers held at once
+};
+
+// One line of JSON with every counter, e.g. {"nodes_expanded": 12, ...}
+string to_json(const LadderStats& stats);
+
+// Outcome of one ladder query; error says why no ladder was found and is empty on success
+struct LadderResult {
+    vector<string> ladder;
+    string error;
+    LadderStats stats;
+};
+
 void error(string word1, string word2, string msg);
 bool edit_distance_within(const std::string& str1, const std::string& str2, int d);
 bool is_adjacent(const string& word1, const string& word2);
 vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list);
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list,
+                                    LadderSearch search);
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const Dictionary& dictionary,
+                                    LadderSearch search = LadderSearch::BFS);
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const LadderIndex& index,
+                                    LadderSearch search = LadderSearch::BFS);
+
+// generate_word_ladder without printing: failures are reported through LadderResult::error,
+// so it is safe to call from several threads at once
+LadderResult find_word_ladder(const string& begin_word, const string& end_word, const LadderIndex& index,
+                              LadderSearch search = LadderSearch::BFS, const ParallelLadderOptions& options = {});
+
+// Answers many (begin, end) queries against one shared index on a pool of threads
+// (0 means one per hardware thread); results come back in input order
+vector<LadderResult> generate_word_ladders(const vector<pair<string, string>>& queries, const LadderIndex& index,
+                                           unsigned threads = 0, LadderSearch search = LadderSearch::BFS);
+
 void load_words(set<string> & word_list, const string& file_name);
 void print_word_ladder(const vector<string>& ladder);
 void verify_word_ladder();
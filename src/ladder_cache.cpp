@@ -0,0 +1,128 @@
+#include "ladder_cache.h"
+#include "ladder.h"
+#include "atomic_file.h"
+#include <bit>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(endian::native == endian::little, "ladder cache files are little-endian");
+
+namespace {
+
+constexpr char CACHE_MAGIC[8] = {'H', 'W', '9', 'L', 'A', 'D', 'R', '\0'};
+constexpr uint32_t CACHE_VERSION = 1;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t word_count;
+    uint64_t edge_count;
+    uint64_t char_count;
+    uint64_t checksum;
+};
+
+size_t cache_file_size(const CacheHeader& header) {
+    return sizeof(CacheHeader) + sizeof(uint32_t) * (2 * (header.word_count + 1) + header.edge_count) + header.char_count;
+}
+
+} // namespace
+
+shared_ptr<const LadderCache> LadderCache::open(const string& file_name, const Dictionary& dictionary) {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd == -1) return nullptr;
+    struct stat info;
+    if (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(CacheHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return nullptr;
+
+    shared_ptr<LadderCache> cache(new LadderCache());
+    cache->mapping = mapping;
+    cache->mapped_size = info.st_size;
+
+    const char* data = static_cast<const char*>(mapping);
+    CacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION
+        || header.word_count != static_cast<uint32_t>(dictionary.size()) || header.checksum != dictionary.checksum()
+        || header.char_count != dictionary.characters().size() || cache_file_size(header) != cache->mapped_size) {
+        return nullptr;
+    }
+
+    const unsigned* offsets = reinterpret_cast<const unsigned*>(data + sizeof(CacheHeader));
+    const unsigned* targets = offsets + header.word_count + 1;
+    const unsigned* word_starts = targets + header.edge_count;
+    const char* characters = reinterpret_cast<const char*>(word_starts + header.word_count + 1);
+
+    // The string table must spell out this exact dictionary...
+    if (memcmp(word_starts, dictionary.word_offsets().data(), sizeof(unsigned) * (header.word_count + 1)) != 0
+        || memcmp(characters, dictionary.characters().data(), header.char_count) != 0) {
+        return nullptr;
+    }
+    // ...and the graph must stay within bounds, so a damaged file is rebuilt rather than trusted
+    if (offsets[0] != 0 || offsets[header.word_count] != header.edge_count) return nullptr;
+    for (uint32_t id = 0; id < header.word_count; id++) {
+        if (offsets[id] > offsets[id + 1]) return nullptr;
+    }
+    for (uint64_t e = 0; e < header.edge_count; e++) {
+        if (targets[e] >= header.word_count) return nullptr;
+    }
+
+    cache->word_count = header.word_count;
+    cache->offsets = offsets;
+    cache->targets = targets;
+    return cache;
+}
+
+LadderCache::~LadderCache() {
+    if (mapping) munmap(mapping, mapped_size);
+}
+
+void write_ladder_cache(const LadderIndex& index, const string& file_name) {
+    const Dictionary& dictionary = index.dictionary();
+    vector<uint32_t> offsets = {0};
+    vector<uint32_t> targets;
+    vector<int> neighbors;
+    for (int id = 0; id < index.size(); id++) {
+        neighbors.clear();
+        index.neighbors(id, neighbors);
+        targets.insert(targets.end(), neighbors.begin(), neighbors.end());
+        offsets.push_back(targets.size());
+    }
+
+    CacheHeader header = {};
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.word_count = dictionary.size();
+    header.edge_count = targets.size();
+    header.char_count = dictionary.characters().size();
+    header.checksum = dictionary.checksum();
+
+    write_file_atomically(file_name, "ladder cache", [&](ofstream& out) {
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(offsets.data()), sizeof(uint32_t) * offsets.size());
+        out.write(reinterpret_cast<const char*>(targets.data()), sizeof(uint32_t) * targets.size());
+        out.write(reinterpret_cast<const char*>(dictionary.word_offsets().data()), sizeof(unsigned) * dictionary.word_offsets().size());
+        out.write(dictionary.characters().data(), dictionary.characters().size());
+    });
+}
+
+LadderIndex load_ladder_index(Dictionary dictionary, const string& cache_file) {
+    if (shared_ptr<const LadderCache> cache = LadderCache::open(cache_file, dictionary)) {
+        return LadderIndex(move(dictionary), move(cache));
+    }
+    LadderIndex index(move(dictionary));
+    try {
+        write_ladder_cache(index, cache_file);
+    } catch (const exception& e) {
+        cerr << "Warning: " << e.what() << endl;
+    }
+    return index;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include "dictionary.h"
+
+using namespace std;
+
+class LadderIndex;
+
+// On-disk copy of the whole edit-distance-1 word graph, so a process can start ladder
+// searches without rebuilding the neighbor index. The file is little-endian:
+//
+//   header       magic, version, word count, edge count, character count and the
+//                checksum of the dictionary it was built from
+//   offsets      word count + 1 uint32 CSR offsets into the neighbor array
+//   neighbors    edge count uint32 word ids, each list in LadderIndex::neighbors order
+//   word starts  word count + 1 uint32 offsets into the character table
+//   characters   the dictionary words back to back
+//
+// The file is memory-mapped and read in place.
+class LadderCache {
+public:
+    // Maps a cache file; returns nullptr if it is missing, malformed, or was built
+    // from a dictionary other than this one
+    static shared_ptr<const LadderCache> open(const string& file_name, const Dictionary& dictionary);
+
+    LadderCache(const LadderCache&) = delete;
+    LadderCache& operator=(const LadderCache&) = delete;
+    ~LadderCache();
+
+    int size() const { return word_count; }
+    size_t edge_count() const { return offsets[word_count]; }
+    span<const unsigned> neighbors(int id) const {
+        return span<const unsigned>(targets + offsets[id], offsets[id + 1] - offsets[id]);
+    }
+
+private:
+    LadderCache() = default;
+
+    void* mapping = nullptr;
+    size_t mapped_size = 0;
+    int word_count = 0;
+    const unsigned* offsets = nullptr;
+    const unsigned* targets = nullptr;
+};
+
+// Precomputes every word's neighbors with the index and writes them as a cache file
+void write_ladder_cache(const LadderIndex& index, const string& file_name);
+
+// Returns an index backed by the cache file when it matches the dictionary; otherwise
+// builds the full index, rewrites the cache file and returns that index
+LadderIndex load_ladder_index(Dictionary dictionary, const string& cache_file);
@@ -1,16 +1,188 @@
 #include "ladder.h"
+#include "ladder_cache.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <deque>
+#include <sstream>
 
-int main() {
-    set<string> word_list;
+// Times one dictionary loader over several runs and reports min / median wall time
+static void time_loader(const string& name, int runs, const function<size_t()>& load) {
+    vector<double> times;
+    size_t words = 0;
+    for (int run = 0; run < runs; run++) {
+        auto start = chrono::steady_clock::now();
+        words = load();
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    sort(times.begin(), times.end());
+    cout << name << ": " << words << " words, min " << times.front() << " ms, median " << times[runs / 2] << " ms" << endl;
+}
+
+static int bench_load(const string& file_name, int runs) {
+    time_loader("set<string> load_words", runs, [&] {
+        set<string> word_list;
+        load_words(word_list, file_name);
+        return word_list.size();
+    });
+    time_loader("Dictionary load_words", runs, [&] {
+        Dictionary dictionary;
+        load_words(dictionary, file_name);
+        return static_cast<size_t>(dictionary.size());
+    });
+    time_loader("Dictionary load_words_mapped", runs, [&] {
+        Dictionary dictionary;
+        load_words_mapped(dictionary, file_name);
+        return static_cast<size_t>(dictionary.size());
+    });
+    return 0;
+}
+
+static int build_cache(const string& file_name, const string& cache_file) {
+    Dictionary dictionary;
+    load_words_mapped(dictionary, file_name);
+    LadderIndex index(move(dictionary));
+    write_ladder_cache(index, cache_file);
+    auto cache = LadderCache::open(cache_file, index.dictionary());
+    if (!cache) {
+        cerr << "Error: " << cache_file << " doesn't validate against " << file_name << " after writing" << endl;
+        return 1;
+    }
+    cout << "Wrote " << cache_file << ": " << index.size() << " words, " << cache->edge_count() << " edges" << endl;
+    return 0;
+}
+
+static void print_result(const string& line, const LadderResult& result, ostream& out) {
+    out << line << ":";
+    if (result.error.empty()) {
+        for (const string& word : result.ladder) out << " " << word;
+    } else {
+        out << " " << result.error;
+    }
+    out << '\n';
+}
+
+// Reads "begin end" lines and answers them on a thread pool sharing one index. Results
+// are written in input order as soon as every earlier query has finished.
+static int run_batch(istream& in, const LadderIndex& index, unsigned threads) {
+    ThreadPool pool(threads);
+    deque<pair<string, future<LadderResult>>> pending;
+    auto flush_ready = [&](bool wait) {
+        while (!pending.empty()) {
+            future<LadderResult>& front = pending.front().second;
+            if (!wait && front.wait_for(chrono::seconds(0)) != future_status::ready) break;
+            print_result(pending.front().first, front.get(), cout);
+            pending.pop_front();
+        }
+    };
+
+    string line;
+    while (getline(in, line)) {
+        istringstream words(line);
+        string begin_word, end_word, extra;
+        if (!(words >> begin_word)) continue;
+        if (!(words >> end_word) || (words >> extra)) {
+            promise<LadderResult> invalid;
+            invalid.set_value({{}, "Expected a start and an end word", {}});
+            pending.emplace_back(line, invalid.get_future());
+        } else {
+            pending.emplace_back(line, pool.submit([&index, begin_word, end_word] {
+                return find_word_ladder(begin_word, end_word, index);
+            }));
+        }
+        flush_ready(false);
+    }
+    flush_ready(true);
+    cout.flush();
+    return 0;
+}
+
+// Runs one query with every search strategy and reports the work each one did, one
+// JSON object per line
+static int compare_searches(const string& begin_word, const string& end_word, const LadderIndex& index) {
+    const pair<LadderSearch, const char*> searches[] = {{LadderSearch::BFS, "bfs"},
+                                                        {LadderSearch::Bidirectional, "bidirectional"},
+                                                        {LadderSearch::Parallel, "parallel"},
+                                                        {LadderSearch::AStar, "astar"}};
+    for (auto [search, name] : searches) {
+        auto start = chrono::steady_clock::now();
+        LadderResult result = find_word_ladder(begin_word, end_word, index, search);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "{\"search\": \"" << name << "\", \"words\": " << result.ladder.size();
+        if (!result.error.empty()) cout << ", \"error\": \"" << result.error << "\"";
+        cout << ", \"ms\": " << ms << ", \"stats\": " << to_json(result.stats) << "}" << endl;
+    }
+    return 0;
+}
+
+// A thread count for --batch: a whole number, 0 for one per hardware thread
+static bool parse_threads(const string& arg, unsigned& threads) {
+    try {
+        size_t used;
+        int count = stoi(arg, &used);
+        if (used != arg.size() || count < 0) return false;
+        threads = count;
+        return true;
+    } catch (const exception&) {
+        return false;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const string words_file = "src/words.txt";
+    const string cache_file = "src/words.ladder";
     try {
-        load_words(word_list, "src/words.txt");
+        if (argc > 1 && string(argv[1]) == "--bench-load") {
+            return bench_load(argc > 2 ? argv[2] : words_file, argc > 3 ? max(1, stoi(argv[3])) : 20);
+        }
+        if (argc > 1 && string(argv[1]) == "--build-cache") {
+            return build_cache(argc > 2 ? argv[2] : words_file, argc > 3 ? argv[3] : cache_file);
+        }
     } catch (const exception& e) {
-        cerr << "Error loading dictionary: " << e.what() << endl;
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    bool batch = argc > 1 && string(argv[1]) == "--batch";
+    bool compare = argc == 4 && string(argv[1]) == "--compare";
+    // --stats also writes the search's LadderStats to stderr as JSON
+    bool print_stats = argc == 2 && string(argv[1]) == "--stats";
+    unsigned threads = 0;
+    if ((argc > 1 && !batch && !compare && !print_stats) || (batch && argc > 3 && !parse_threads(argv[3], threads))) {
+        cerr << "Usage: " << argv[0] << " [--stats | --batch [queries_file|-] [threads] | --compare begin_word end_word"
+             << " | --bench-load [words_file] [runs] | --build-cache [words_file] [cache_file]]" << endl;
         return 1;
     }
+
+    Dictionary dictionary;
+    load_words_mapped(dictionary, words_file);
+    // Reuses the precomputed word graph, rebuilding it if words.txt has changed
+    LadderIndex index = load_ladder_index(move(dictionary), cache_file);
+    const Dictionary& word_list = index.dictionary();
+
+    if (compare) {
+        return compare_searches(argv[2], argv[3], index);
+    }
+    if (batch) {
+        string queries_file = argc > 2 ? argv[2] : "-";
+        try {
+            if (queries_file == "-") {
+                return run_batch(cin, index, threads);
+            }
+            ifstream queries(queries_file);
+            if (!queries) {
+                cerr << "Error: Could not open file " << queries_file << endl;
+                return 1;
+            }
+            return run_batch(queries, index, threads);
+        } catch (const exception& e) {
+            // Such as a thread count the system can't start
+            cerr << "Error: " << e.what() << endl;
+            return 1;
+        }
+    }
     
     string begin_word, end_word;
     
@@ -28,12 +200,17 @@ int main() {
         return 1;
     }
     
-    if (word_list.find(end_word) == word_list.end()) {
+    if (!word_list.contains(end_word)) {
         error(begin_word, end_word, "End word not found in dictionary");
         return 1;
     }
     
-    vector<string> ladder = generate_word_ladder(begin_word, end_word, word_list);
+    // What generate_word_ladder does, keeping the stats
+    LadderResult result = find_word_ladder(begin_word, end_word, index);
+    if (!result.error.empty()) {
+        error(begin_word, end_word, result.error);
+    }
+    vector<string>& ladder = result.ladder;
     
     if (ladder.empty()) {
         cout << "No word ladder found between '" << begin_word << "' and '" << end_word << "'." << endl;
@@ -41,9 +218,12 @@ int main() {
         cout << "Word ladder from '" << begin_word << "' to '" << end_word << "':" << endl;
         print_word_ladder(ladder);
     }
+    if (print_stats) {
+        cerr << to_json(result.stats) << endl;
+    }
     
     return 0;
 }
 
 // g++ -std=c++17 -o ladder src/ladder_main.cpp src/ladder.cpp
-// ./ladder
\ No newline at end of file
+// ./ladder
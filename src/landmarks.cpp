@@ -0,0 +1,113 @@
+#include "landmarks.h"
+#include "priority_queues.h"
+#include <algorithm>
+
+Landmarks::Landmarks(const CSRGraph& G, int count) {
+    int n = G.numVertices;
+    count = min(count, n);
+    if (count < 0) {
+        throw runtime_error("Landmark count can't be negative");
+    }
+    CSRGraph reversed = reverse_graph(G);
+    from.resize(size_t(n) * count);
+    to.resize(size_t(n) * count);
+
+    // closest[v] is v's distance from the nearest landmark so far; unreached vertices
+    // stay at INF and are picked first, so every component gets a landmark
+    vector<int> closest(n, INF);
+    vector<int> previous;
+    int next = 0;
+    for (int i = 0; i < count; ++i) {
+        landmarks.push_back(next);
+        vector<int> forward = dijkstra_shortest_path(G, next, previous);
+        vector<int> backward = dijkstra_shortest_path(reversed, next, previous);
+        for (int v = 0; v < n; ++v) {
+            from[size_t(v) * count + i] = forward[v];
+            to[size_t(v) * count + i] = backward[v];
+            closest[v] = min(closest[v], forward[v]);
+        }
+        for (int landmark : landmarks) {
+            closest[landmark] = -1;
+        }
+        next = max_element(closest.begin(), closest.end()) - closest.begin();
+    }
+}
+
+int Landmarks::lower_bound(int v, int target) const {
+    int k = count();
+    const int* from_v = from.data() + size_t(v) * k;
+    const int* from_t = from.data() + size_t(target) * k;
+    const int* to_v = to.data() + size_t(v) * k;
+    const int* to_t = to.data() + size_t(target) * k;
+    int bound = 0;
+    for (int i = 0; i < k; ++i) {
+        // L reaches v but not target, or target reaches L but v doesn't: v can't reach target
+        if ((from_v[i] != INF && from_t[i] == INF) || (to_t[i] != INF && to_v[i] == INF)) {
+            return INF;
+        }
+        if (from_t[i] != INF && from_v[i] != INF) bound = max(bound, from_t[i] - from_v[i]);
+        if (to_v[i] != INF && to_t[i] != INF) bound = max(bound, to_v[i] - to_t[i]);
+    }
+    return bound;
+}
+
+ShortestPath alt_shortest_path(const CSRGraph& G, const Landmarks& landmarks, int source, int target) {
+    int n = G.numVertices;
+    check_vertex(source, n);
+    check_vertex(target, n);
+    if (landmarks.count() > 0 && landmarks.numVertices() != n) {
+        throw runtime_error("Landmarks were built for " + to_string(landmarks.numVertices()) + " vertices, not "
+                            + to_string(n));
+    }
+
+    // The bounds are consistent, so a vertex's distance is final once it is popped
+    // and the search is plain Dijkstra on the reduced costs
+    vector<int> distances(n, INF);
+    vector<int> previous(n, -1);
+    vector<int> bounds(n, -1);
+    IndexedDaryHeap<4> heap(n);
+    ShortestPath result;
+    auto bound = [&](int v) {
+        if (bounds[v] == -1) bounds[v] = landmarks.lower_bound(v, target);
+        return bounds[v];
+    };
+
+    if (bound(source) == INF) {
+        return result;
+    }
+    distances[source] = 0;
+    heap.push(source, bound(source));
+    bool overflowed = false;
+    while (!heap.empty()) {
+        int u = heap.pop();
+        ++result.settled;
+        if (u == target) {
+            result.distance = distances[u];
+            result.path = extract_shortest_path(distances, previous, target);
+            break;
+        }
+        for (int i = G.offsets[u]; i < G.offsets[u + 1]; ++i) {
+            int v = G.dst[i];
+            int distance, key;
+            if (!add_path_length(distances[u], G.weight[i], distance)) {
+                overflowed = true;
+                continue;
+            }
+            if (distance < distances[v] && bound(v) != INF) {
+                // The key bounds the whole path through v, so one too long for int is skipped too
+                if (!add_path_length(distance, bounds[v], key)) {
+                    overflowed = true;
+                    continue;
+                }
+                distances[v] = distance;
+                previous[v] = u;
+                heap.push(v, key);
+            }
+        }
+    }
+    // As in bidirectional_shortest_path, skipped overflows leave the verdict to Dijkstra
+    if (result.distance == INF && overflowed) {
+        return shortest_path(G, source, target);
+    }
+    return result;
+}
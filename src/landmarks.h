@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include "dijkstras.h"
+
+using namespace std;
+
+// Landmark distances for ALT queries (A*, landmarks, triangle inequality). For each
+// landmark L it keeps d(L, v) and d(v, L) for every vertex v, computed with
+// dijkstra_shortest_path on the graph and on its reverse. The triangle inequality then
+// gives lower bounds on d(v, t) for any target t:
+//
+//   d(v, t) >= d(L, t) - d(L, v)      d(v, t) >= d(v, L) - d(t, L)
+//
+// Landmarks are chosen farthest-first: each new one is the vertex farthest from those
+// already picked, which tends to put them on the edge of the graph where the bounds are
+// tightest. Needs non-negative weights.
+class Landmarks {
+public:
+    Landmarks() = default;
+    Landmarks(const CSRGraph& G, int count);
+
+    int count() const { return landmarks.size(); }
+    int numVertices() const { return count() == 0 ? 0 : from.size() / count(); }
+    const vector<int>& vertices() const { return landmarks; }
+
+    // Largest lower bound on d(v, target) over all landmarks, or INF when some
+    // landmark shows target can't be reached from v
+    int lower_bound(int v, int target) const;
+
+private:
+    vector<int> landmarks;
+    vector<int> from;   // from[v * count() + i] = d(landmarks[i], v)
+    vector<int> to;     // to[v * count() + i] = d(v, landmarks[i])
+};
+
+// A* from source to target guided by the landmark bounds. Gives the same distance as
+// shortest_path while settling fewer vertices; the path is another shortest one when
+// several tie.
+ShortestPath alt_shortest_path(const CSRGraph& G, const Landmarks& landmarks, int source, int target);
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Min-priority queues over vertex ids for dijkstra_shortest_path. They share one interface:
+//
+//   push(v, key)   make v's key `key`; callers only ever lower a vertex's key
+//   pop()          remove and return a vertex with the smallest key
+//   empty()
+//
+// "Lazy" queues keep stale copies of re-pushed vertices and may pop a vertex again
+// after it has been settled; Dijkstra skips those. The heaps break ties by vertex id.
+// The radix heap and bucket queue are monotone: a push may never go below the key
+// most recently popped, which holds for Dijkstra with non-negative weights.
+
+// std::priority_queue of (key, vertex) pairs; a push never updates an existing entry,
+// so the heap can hold O(E) entries. The binary and 4-ary heaps take any ordered Key,
+// for Dijkstra over non-int weights; the radix heap and bucket queue take int keys.
+template <class Key = int>
+class LazyBinaryHeap {
+public:
+    explicit LazyBinaryHeap(int /*numVertices*/) {}
+
+    bool empty() const { return heap.empty(); }
+    void push(int v, Key key) { heap.push({key, v}); }
+    int pop() {
+        int v = heap.top().second;
+        heap.pop();
+        return v;
+    }
+
+private:
+    priority_queue<pair<Key, int>, vector<pair<Key, int>>, greater<pair<Key, int>>> heap;
+};
+
+// D-ary heap that tracks each vertex's slot, so a push for a queued vertex is a
+// decrease-key in place. It never holds more than one entry per vertex, and the
+// wider nodes make it shallower than a binary heap, with fewer cache misses per sift.
+template <int D = 4, class Key = int>
+class IndexedDaryHeap {
+public:
+    explicit IndexedDaryHeap(int numVertices) : position(numVertices, -1) {}
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return heap.size(); }
+    bool contains(int v) const { return position[v] != -1; }
+    Key min_key() const { return heap[0].first; }
+    void clear() {
+        for (const auto& entry : heap) position[entry.second] = -1;
+        heap.clear();
+    }
+
+    void push(int v, Key key) {
+        if (position[v] == -1) {
+            position[v] = heap.size();
+            heap.push_back({key, v});
+        } else {
+            heap[position[v]].first = key;
+        }
+        sift_up(position[v]);
+    }
+
+    int pop() {
+        int v = heap[0].second;
+        position[v] = -1;
+        if (heap.size() > 1) {
+            heap[0] = heap.back();
+            position[heap[0].second] = 0;
+            heap.pop_back();
+            sift_down(0);
+        } else {
+            heap.pop_back();
+        }
+        return v;
+    }
+
+private:
+    void sift_up(int i) {
+        pair<Key, int> entry = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (!(entry < heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, entry);
+    }
+
+    void sift_down(int i) {
+        pair<Key, int> entry = heap[i];
+        int n = heap.size();
+        for (;;) {
+            int first = D * i + 1;
+            if (first >= n) break;
+            int best = first;
+            for (int c = first + 1; c < min(first + D, n); ++c) {
+                if (heap[c] < heap[best]) best = c;
+            }
+            if (!(heap[best] < entry)) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, entry);
+    }
+
+    void place(int i, const pair<Key, int>& entry) {
+        heap[i] = entry;
+        position[entry.second] = i;
+    }
+
+    vector<pair<Key, int>> heap;  // (key, vertex)
+    vector<int> position;         // Slot of each vertex in heap, -1 when absent
+};
+
+// Monotone radix heap for non-negative integer keys (lazy). Bucket 0 holds keys equal
+// to the last popped key, and bucket i > 0 holds keys whose highest bit differing from
+// it is bit i - 1. Popping from an empty bucket 0 takes the lowest non-empty bucket,
+// makes its minimum the new last key and spreads it over lower buckets, so each entry
+// moves at most 32 times and no comparisons between entries are needed.
+class RadixHeap {
+public:
+    explicit RadixHeap(int /*numVertices*/) {}
+
+    bool empty() const { return count == 0; }
+
+    void push(int v, int key) {
+        unsigned k = key;
+        buckets[bucket_of(k)].push_back({k, v});
+        ++count;
+    }
+
+    int pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+            last = buckets[i][0].first;
+            for (const auto& entry : buckets[i]) last = min(last, entry.first);
+            for (const auto& entry : buckets[i]) buckets[bucket_of(entry.first)].push_back(entry);
+            buckets[i].clear();
+        }
+        int v = buckets[0].back().second;
+        buckets[0].pop_back();
+        --count;
+        return v;
+    }
+
+private:
+    int bucket_of(unsigned key) const { return bit_width(key ^ last); }
+
+    array<vector<pair<unsigned, int>>, 33> buckets;  // (key, vertex)
+    unsigned last = 0;
+    size_t count = 0;
+};
+
+// Dial's bucket queue for integer keys drawn from edge weights in 0..maxWeight (lazy).
+// Every queued key lies within maxWeight of the last popped key, so a circular array
+// of maxWeight + 1 buckets holds one key per bucket, and pop just walks forward to
+// the next non-empty bucket.
+class DialBucketQueue {
+public:
+    DialBucketQueue(int /*numVertices*/, int maxWeight) : buckets(size_t(maxWeight) + 1) {}
+
+    bool empty() const { return count == 0; }
+
+    void push(int v, int key) {
+        buckets[size_t(key) % buckets.size()].push_back(v);
+        ++count;
+    }
+
+    int pop() {
+        while (buckets[current].empty()) {
+            current = current + 1 == buckets.size() ? 0 : current + 1;
+        }
+        int v = buckets[current].back();
+        buckets[current].pop_back();
+        --count;
+        return v;
+    }
+
+private:
+    vector<vector<int>> buckets;
+    size_t current = 0;
+    size_t count = 0;
+};
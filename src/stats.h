@@ -0,0 +1,11 @@
+#pragma once
+
+// Work counters in the search hot paths (DijkstraStats, LadderStats). They are compiled
+// in by default; building with -DHW9_STATS=0 (the HW9_STATS CMake option, or always for
+// the benchmarks target) removes every count, and the counters then stay zero. Counts
+// the searches need for their own results, like ShortestPath::settled, are kept either way.
+#ifndef HW9_STATS
+#define HW9_STATS 1
+#endif
+
+constexpr bool STATS_ENABLED = HW9_STATS;
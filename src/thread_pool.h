@@ -0,0 +1,71 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// Fixed set of worker threads pulling tasks from a shared FIFO queue.
+// submit() returns a future for the task's result; the destructor finishes
+// every queued task before joining the workers. The semaphore counts queued
+// tasks plus one wake-up per worker at shutdown.
+class ThreadPool {
+public:
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(unsigned threads = 0) {
+        if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+        for (unsigned i = 0; i < threads; i++) {
+            workers.emplace_back([this] { run(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        // Workers exit on the first wake-up that finds the queue empty
+        task_ready.release(workers.size());
+        for (thread& worker : workers) worker.join();
+    }
+
+    unsigned size() const { return workers.size(); }
+
+    template <class F>
+    future<invoke_result_t<F>> submit(F task) {
+        auto packaged = make_shared<packaged_task<invoke_result_t<F>()>>(move(task));
+        future<invoke_result_t<F>> result = packaged->get_future();
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            tasks.emplace([packaged] { (*packaged)(); });
+        }
+        task_ready.release();
+        return result;
+    }
+
+private:
+    void run() {
+        for (;;) {
+            task_ready.acquire();
+            function<void()> task;
+            {
+                lock_guard<mutex> lock(queue_mutex);
+                if (tasks.empty()) return;
+                task = move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex queue_mutex;
+    counting_semaphore<> task_ready{0};
+};